@@ -0,0 +1,340 @@
+-- aseprite_mock.lua
+-- Minimal stand-in for the parts of the Aseprite scripting API the render,
+-- voxel generation and export modules touch, so they run headless under
+-- stock lua5.4. Not a general emulator: only what loader.lua needs to load
+-- every module, plus app, Image, Color, Point, Rectangle, Sprite and
+-- app.pixelColor with Aseprite's pixel layout.
+--
+--   local mock = dofile("bench/aseprite_mock.lua")
+--   mock.install()                       -- defines the globals
+--   local sprite = mock.spriteFromVoxels(voxels)
+
+local mock = {}
+
+--------------------------------------------------------------------------------
+-- Pixels (RGBA packed as in Aseprite: r | g<<8 | b<<16 | a<<24)
+--------------------------------------------------------------------------------
+local pixelColor = {}
+
+function pixelColor.rgba(r, g, b, a)
+  a = a or 255
+  return ((a & 255) << 24) | ((b & 255) << 16) | ((g & 255) << 8) | (r & 255)
+end
+function pixelColor.rgbaR(c) return c & 255 end
+function pixelColor.rgbaG(c) return (c >> 8) & 255 end
+function pixelColor.rgbaB(c) return (c >> 16) & 255 end
+function pixelColor.rgbaA(c) return (c >> 24) & 255 end
+
+--------------------------------------------------------------------------------
+-- Color
+--------------------------------------------------------------------------------
+local ColorMT = { __name = "Color" }
+ColorMT.__index = function(c, k)
+  if k == "rgbaPixel" then return pixelColor.rgba(c.red, c.green, c.blue, c.alpha) end
+  return nil
+end
+ColorMT.__eq = function(a, b)
+  return a.red == b.red and a.green == b.green and a.blue == b.blue and a.alpha == b.alpha
+end
+
+local function clamp8(v) return math.max(0, math.min(255, math.floor((v or 0) + 0.5))) end
+
+local function Color(r, g, b, a)
+  if type(r) == "table" then
+    local t = r
+    r = t.red or t.r
+    g = t.green or t.g
+    b = t.blue or t.b
+    a = t.alpha or t.a
+  elseif type(r) == "number" and g == nil then
+    -- Color(pixelValue)
+    local px = r
+    r, g, b, a = pixelColor.rgbaR(px), pixelColor.rgbaG(px), pixelColor.rgbaB(px), pixelColor.rgbaA(px)
+  end
+  return setmetatable({
+    red = clamp8(r), green = clamp8(g), blue = clamp8(b), alpha = a == nil and 255 or clamp8(a)
+  }, ColorMT)
+end
+
+local function toPixel(c)
+  if type(c) == "number" then return c end
+  return pixelColor.rgba(clamp8(c.red or c.r), clamp8(c.green or c.g), clamp8(c.blue or c.b),
+    clamp8(c.alpha or c.a or 255))
+end
+
+--------------------------------------------------------------------------------
+-- Geometry
+--------------------------------------------------------------------------------
+local function Point(x, y)
+  if type(x) == "table" then return { x = x.x, y = x.y } end
+  return { x = x or 0, y = y or 0 }
+end
+
+local function Rectangle(x, y, w, h)
+  if type(x) == "table" then return { x = x.x, y = x.y, width = x.width, height = x.height } end
+  return { x = x or 0, y = y or 0, width = w or 0, height = h or 0 }
+end
+
+local function Size(w, h) return { width = w or 0, height = h or 0 } end
+
+--------------------------------------------------------------------------------
+-- Image: flat pixel array; id/version/bytes as in Aseprite
+--------------------------------------------------------------------------------
+local Image
+local ImageMethods = {}
+local _nextImageId = 0
+
+local ImageMT = { __name = "Image" }
+ImageMT.__index = function(img, k)
+  if k == "bytes" then
+    local parts = {}
+    for i = 1, img.width * img.height do
+      parts[i] = string.pack("<I4", img._px[i])
+    end
+    return table.concat(parts)
+  elseif k == "bounds" then
+    return Rectangle(0, 0, img.width, img.height)
+  end
+  return ImageMethods[k]
+end
+
+Image = function(a, b, c)
+  if type(a) == "table" and a._px then
+    -- Image(otherImage): copy
+    local src = a
+    local img = Image(src.width, src.height, src.colorMode)
+    table.move(src._px, 1, #src._px, 1, img._px)
+    return img
+  end
+  local w, h, mode = a, b, c
+  if type(a) == "table" then w, h, mode = a.width, a.height, a.colorMode end
+  _nextImageId = _nextImageId + 1
+  local px = {}
+  for i = 1, w * h do px[i] = 0 end
+  return setmetatable({
+    width = w, height = h, colorMode = mode or 0, id = _nextImageId, version = 0, _px = px
+  }, ImageMT)
+end
+
+function ImageMethods:getPixel(x, y)
+  if x < 0 or y < 0 or x >= self.width or y >= self.height then return 0 end
+  return self._px[y * self.width + x + 1]
+end
+
+function ImageMethods:putPixel(x, y, c)
+  x, y = math.floor(x), math.floor(y)
+  if x < 0 or y < 0 or x >= self.width or y >= self.height then return end
+  self._px[y * self.width + x + 1] = toPixel(c)
+  self.version = self.version + 1
+end
+ImageMethods.drawPixel = ImageMethods.putPixel
+
+function ImageMethods:clear(c)
+  local p = toPixel(c or 0)
+  local px = self._px
+  for i = 1, self.width * self.height do px[i] = p end
+  self.version = self.version + 1
+end
+
+-- Aseprite composites with the source alpha; plain copy keeps benchmarks
+-- independent of blend math the extension never relies on.
+function ImageMethods:drawImage(src, x, y)
+  if type(x) == "table" then x, y = x.x, x.y end
+  x, y = x or 0, y or 0
+  for sy = 0, src.height - 1 do
+    for sx = 0, src.width - 1 do
+      local p = src._px[sy * src.width + sx + 1]
+      if pixelColor.rgbaA(p) > 0 then self:putPixel(x + sx, y + sy, p) end
+    end
+  end
+end
+
+function ImageMethods:clone() return Image(self) end
+
+function ImageMethods:resize(w, h)
+  local src = Image(self)
+  local px = {}
+  for y = 0, h - 1 do
+    for x = 0, w - 1 do
+      px[y * w + x + 1] = src:getPixel(x * src.width // w, y * src.height // h)
+    end
+  end
+  self.width, self.height, self._px = w, h, px
+  self.version = self.version + 1
+end
+
+function ImageMethods:pixels()
+  local i, n, img = 0, self.width * self.height, self
+  return function()
+    i = i + 1
+    if i > n then return nil end
+    local idx = i
+    return setmetatable({ x = (idx - 1) % img.width, y = (idx - 1) // img.width }, {
+      __call = function(_, v)
+        if v ~= nil then img._px[idx] = toPixel(v) end
+        return img._px[idx]
+      end
+    })
+  end
+end
+
+--------------------------------------------------------------------------------
+-- Sprite / Layer / Cel (only the members voxel generation reads)
+--------------------------------------------------------------------------------
+local function newLayer(sprite, name)
+  local layer = { name = name, isGroup = false, isVisible = true, sprite = sprite, _cels = {} }
+  function layer:cel(frame)
+    local n = type(frame) == "table" and frame.frameNumber or frame
+    return self._cels[n]
+  end
+  sprite.layers[#sprite.layers + 1] = layer
+  return layer
+end
+
+local function Sprite(w, h, mode)
+  local sprite = {
+    width = w, height = h, colorMode = mode or 0, layers = {}, frames = { { frameNumber = 1 } }
+  }
+  sprite.bounds = Rectangle(0, 0, w, h)
+  function sprite:newLayer() return newLayer(self, "Layer " .. (#self.layers + 1)) end
+  function sprite:newEmptyFrame(n)
+    n = n or #self.frames + 1
+    table.insert(self.frames, n, { frameNumber = n })
+    for i, f in ipairs(self.frames) do f.frameNumber = i end
+    return self.frames[n]
+  end
+  function sprite:newCel(layer, frame, image, position)
+    local n = type(frame) == "table" and frame.frameNumber or frame
+    local cel = { layer = layer, frameNumber = n, image = image or Image(w, h, mode),
+                  position = Point(position or Point(0, 0)) }
+    layer._cels[n] = cel
+    return cel
+  end
+  return sprite
+end
+
+-- One layer per z slice (z = layer index, as the voxel generator reads it);
+-- each cel image is cropped to its slice bounds.
+function mock.spriteFromVoxels(voxels)
+  local minX, minY, maxX, maxY = math.huge, math.huge, -math.huge, -math.huge
+  local minZ, maxZ = math.huge, -math.huge
+  for _, v in ipairs(voxels) do
+    minX, maxX = math.min(minX, v.x), math.max(maxX, v.x)
+    minY, maxY = math.min(minY, v.y), math.max(maxY, v.y)
+    minZ, maxZ = math.min(minZ, v.z), math.max(maxZ, v.z)
+  end
+  local sprite = Sprite(maxX - minX + 1, maxY - minY + 1, 0)
+  local slices = {}
+  for _, v in ipairs(voxels) do
+    local z = v.z - minZ + 1
+    slices[z] = slices[z] or {}
+    table.insert(slices[z], v)
+  end
+  for z = 1, maxZ - minZ + 1 do
+    local layer = sprite:newLayer()
+    local slice = slices[z]
+    if slice then
+      local sx0, sy0, sx1, sy1 = math.huge, math.huge, -math.huge, -math.huge
+      for _, v in ipairs(slice) do
+        sx0, sx1 = math.min(sx0, v.x), math.max(sx1, v.x)
+        sy0, sy1 = math.min(sy0, v.y), math.max(sy1, v.y)
+      end
+      local img = Image(sx1 - sx0 + 1, sy1 - sy0 + 1, 0)
+      for _, v in ipairs(slice) do
+        local c = v.color
+        img:putPixel(v.x - sx0, v.y - sy0, pixelColor.rgba(c.r, c.g, c.b, c.a))
+      end
+      sprite:newCel(layer, 1, img, Point(sx0 - minX, sy0 - minY))
+    end
+  end
+  return sprite
+end
+
+--------------------------------------------------------------------------------
+-- app
+--------------------------------------------------------------------------------
+local sep = package.config:sub(1, 1)
+
+local fs = { pathSeparator = sep }
+function fs.joinPath(...)
+  local parts = {}
+  for _, p in ipairs({ ... }) do
+    if p ~= "" then parts[#parts + 1] = (p:gsub("[/\\]$", "")) end
+  end
+  return table.concat(parts, sep)
+end
+function fs.fileName(p) return p:match("([^/\\]*)$") end
+function fs.filePath(p) return p:match("^(.*)[/\\]") or "" end
+function fs.fileExtension(p) return fs.fileName(p):match("%.([^.]*)$") or "" end
+function fs.fileTitle(p) return (fs.fileName(p):gsub("%.[^.]*$", "")) end
+function fs.isDirectory(p)
+  local f = io.open(p, "rb")
+  if not f then return false end
+  local _, _, code = f:read(1)
+  f:close()
+  return code == 21 -- EISDIR
+end
+function fs.isFile(p)
+  local f = io.open(p, "rb")
+  if not f then return false end
+  f:close()
+  return not fs.isDirectory(p)
+end
+function fs.makeDirectory(p) return os.execute(string.format('mkdir "%s"', p)) end
+function fs.makeAllDirectories(p)
+  return os.execute(sep == "\\" and string.format('mkdir "%s"', p) or string.format('mkdir -p "%s"', p))
+end
+function fs.listFiles() return {} end
+fs.currentPath = "."
+fs.userConfigPath = os.getenv("TMPDIR") or "/tmp"
+
+local function makeApp()
+  return {
+    version = "1.3-mock",
+    apiVersion = 30,
+    fs = fs,
+    pixelColor = pixelColor,
+    activeSprite = nil,
+    activeFrame = { frameNumber = 1 },
+    activeLayer = nil,
+    alert = function(msg)
+      io.stderr:write("[alert] " .. tostring(type(msg) == "table" and msg.text or msg) .. "\n")
+    end,
+    transaction = function(a, b) local fn = b or a return fn() end,
+    refresh = function() end,
+    wait = function() end,
+    command = setmetatable({}, { __index = function() return function() end end })
+  }
+end
+
+-- Timers never fire on their own; benches drive any ticking explicitly
+local function Timer(opts)
+  return {
+    interval = opts and opts.interval, ontick = opts and opts.ontick, isRunning = false,
+    start = function(self) self.isRunning = true end,
+    stop = function(self) self.isRunning = false end
+  }
+end
+
+--------------------------------------------------------------------------------
+-- Install globals
+--------------------------------------------------------------------------------
+function mock.install(env)
+  env = env or _G
+  env.ColorMode = { RGB = 0, GRAY = 1, INDEXED = 2 }
+  env.BlendMode = { NORMAL = 0 }
+  env.Color = Color
+  env.Point = Point
+  env.Rectangle = Rectangle
+  env.Size = Size
+  env.Image = Image
+  env.Sprite = Sprite
+  env.Timer = Timer
+  env.app = makeApp()
+  return env.app
+end
+
+mock.pixelColor = pixelColor
+mock.Image = Image
+
+return mock
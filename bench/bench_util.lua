@@ -0,0 +1,163 @@
+-- bench_util.lua
+-- Shared helpers for the headless benchmark runners: repo paths, argument
+-- parsing, sweep lists and a small ordered JSON writer. Percentiles come
+-- from utils/performance_profiler.lua, the same code the Debug tab uses.
+
+local benchUtil = {}
+
+local sep = package.config:sub(1, 1)
+benchUtil.sep = sep
+
+-- Repository root (parent of bench/)
+do
+  local src = debug.getinfo(1, "S").source
+  if src:sub(1, 1) == "@" then src = src:sub(2) end
+  local dir = src:match("^(.*)[/\\]") or "."
+  benchUtil.benchDir = dir
+  benchUtil.root = dir:match("^(.*)[/\\][^/\\]+$") or (dir == "." and ".." or ".")
+end
+
+function benchUtil.path(...)
+  return table.concat({ benchUtil.root, ... }, sep)
+end
+
+-- Loads a repo module file (relative to the root, without .lua)
+function benchUtil.load(relPath)
+  return dofile(benchUtil.path((relPath:gsub("/", sep))) .. ".lua")
+end
+
+--------------------------------------------------------------------------------
+-- Arguments: --name value | --flag ; lists are comma separated
+--------------------------------------------------------------------------------
+function benchUtil.parseArgs(argv, defaults)
+  local opts = {}
+  for k, v in pairs(defaults or {}) do opts[k] = v end
+  local i = 1
+  while argv and i <= #argv do
+    local a = argv[i]
+    local name = a:match("^%-%-([%w%-]+)$")
+    if not name then error("unexpected argument: " .. a) end
+    name = name:gsub("%-(%w)", string.upper)
+    local nxt = argv[i + 1]
+    if nxt == nil or nxt:match("^%-%-") then
+      opts[name] = true
+      i = i + 1
+    else
+      opts[name] = nxt
+      i = i + 2
+    end
+  end
+  return opts
+end
+
+function benchUtil.list(v, asNumber)
+  if type(v) == "table" then return v end
+  local out = {}
+  for item in tostring(v):gmatch("[^,]+") do
+    out[#out + 1] = asNumber and tonumber(item) or item
+  end
+  return out
+end
+
+-- "x:y:z" rotation triples
+function benchUtil.rotations(v)
+  local out = {}
+  for _, item in ipairs(benchUtil.list(v)) do
+    local x, y, z = item:match("^(%-?[%d%.]+):(%-?[%d%.]+):(%-?[%d%.]+)$")
+    if not x then error("rotation must be x:y:z, got " .. item) end
+    out[#out + 1] = { x = tonumber(x), y = tonumber(y), z = tonumber(z) }
+  end
+  return out
+end
+
+--------------------------------------------------------------------------------
+-- Stats
+--------------------------------------------------------------------------------
+function benchUtil.newProfiler(maxSamples)
+  local profiler = benchUtil.load("utils/performance_profiler")
+  profiler._maxSamples = maxSamples or 1000
+  return profiler
+end
+
+-- { section = { count, mean, median, min, max, p75, p90, p95, p99 } }
+function benchUtil.sectionStats(profiler, profileName)
+  local out = {}
+  for name, s in pairs(profiler.getStats(profileName) or {}) do
+    out[name] = {
+      count = s.count, mean = s.mean, median = s.median, min = s.min, max = s.max,
+      p75 = s.p75, p90 = s.p90, p95 = s.p95, p99 = s.p99
+    }
+  end
+  return out
+end
+
+--------------------------------------------------------------------------------
+-- JSON (keys sorted so result files diff cleanly)
+--------------------------------------------------------------------------------
+local function encode(v, out, indent)
+  local t = type(v)
+  if t == "table" then
+    local pad = string.rep("  ", indent + 1)
+    if #v > 0 or next(v) == nil then
+      out[#out + 1] = "["
+      for i, item in ipairs(v) do
+        out[#out + 1] = (i > 1 and ",\n" or "\n") .. pad
+        encode(item, out, indent + 1)
+      end
+      out[#out + 1] = (#v > 0 and "\n" .. string.rep("  ", indent) or "") .. "]"
+    else
+      local keys = {}
+      for k in pairs(v) do keys[#keys + 1] = tostring(k) end
+      table.sort(keys)
+      out[#out + 1] = "{"
+      for i, k in ipairs(keys) do
+        out[#out + 1] = (i > 1 and ",\n" or "\n") .. pad .. string.format("%q", k) .. ": "
+        local val = v[k]
+        if val == nil then val = v[tonumber(k)] end
+        encode(val, out, indent + 1)
+      end
+      out[#out + 1] = "\n" .. string.rep("  ", indent) .. "}"
+    end
+  elseif t == "number" then
+    if v ~= v or v == math.huge or v == -math.huge then
+      out[#out + 1] = "null"
+    elseif math.type(v) == "integer" then
+      out[#out + 1] = tostring(v)
+    else
+      out[#out + 1] = string.format("%.4f", v)
+    end
+  elseif t == "string" then
+    out[#out + 1] = '"' .. v:gsub('[%c"\\]', function(c)
+      return string.format("\\u%04x", c:byte())
+    end) .. '"'
+  elseif t == "boolean" then
+    out[#out + 1] = tostring(v)
+  else
+    out[#out + 1] = "null"
+  end
+end
+
+function benchUtil.toJSON(v)
+  local out = {}
+  encode(v, out, 0)
+  return table.concat(out) .. "\n"
+end
+
+-- Writes to opts.out when set, stdout otherwise
+function benchUtil.emit(result, outPath)
+  local text = benchUtil.toJSON(result)
+  if outPath and outPath ~= true then
+    local f = assert(io.open(outPath, "w"))
+    f:write(text)
+    f:close()
+    io.stderr:write("wrote " .. outPath .. "\n")
+  else
+    io.write(text)
+  end
+end
+
+function benchUtil.log(fmt, ...)
+  io.stderr:write(string.format(fmt, ...) .. "\n")
+end
+
+return benchUtil
@@ -0,0 +1,163 @@
+-- fixtures.lua
+-- Procedural voxel models for benchmarks (same { x, y, z, color } layout the
+-- voxel generator produces). Every generator is deterministic so runs on
+-- different machines render identical scenes.
+
+local fixtures = {}
+
+local function voxel(x, y, z, r, g, b)
+  return { x = x, y = y, z = z, color = { r = r, g = g, b = b, a = 255 } }
+end
+
+--------------------------------------------------------------------------------
+-- Solid cube: n^3 voxels, colored by position
+--------------------------------------------------------------------------------
+function fixtures.cube(n)
+  local out = {}
+  local k = 255 / math.max(1, n - 1)
+  for z = 0, n - 1 do
+    for y = 0, n - 1 do
+      for x = 0, n - 1 do
+        out[#out + 1] = voxel(x, y, z, math.floor(x * k), math.floor(y * k), math.floor(z * k))
+      end
+    end
+  end
+  return out
+end
+
+--------------------------------------------------------------------------------
+-- Hollow sphere: one-voxel shell of diameter n (all voxels on the surface)
+--------------------------------------------------------------------------------
+function fixtures.sphere(n)
+  local out = {}
+  local c = (n - 1) / 2
+  local r = n / 2
+  for z = 0, n - 1 do
+    for y = 0, n - 1 do
+      for x = 0, n - 1 do
+        local dx, dy, dz = x - c, y - c, z - c
+        local d = math.sqrt(dx * dx + dy * dy + dz * dz)
+        if d <= r and d > r - 1 then
+          out[#out + 1] = voxel(x, y, z, 230, math.floor(120 + 100 * y / n), 60)
+        end
+      end
+    end
+  end
+  return out
+end
+
+--------------------------------------------------------------------------------
+-- Menger sponge: largest level with 3^level <= n (lots of internal faces)
+--------------------------------------------------------------------------------
+function fixtures.menger(n)
+  local size = 1
+  while size * 3 <= n do size = size * 3 end
+  local out = {}
+  for z = 0, size - 1 do
+    for y = 0, size - 1 do
+      for x = 0, size - 1 do
+        local a, b, c, hole = x, y, z, false
+        while a > 0 or b > 0 or c > 0 do
+          local ones = (a % 3 == 1 and 1 or 0) + (b % 3 == 1 and 1 or 0) + (c % 3 == 1 and 1 or 0)
+          if ones >= 2 then hole = true break end
+          a, b, c = a // 3, b // 3, c // 3
+        end
+        if not hole then
+          out[#out + 1] = voxel(x, y, z, 200, 200, math.floor(255 * z / size))
+        end
+      end
+    end
+  end
+  return out
+end
+
+--------------------------------------------------------------------------------
+-- Noise terrain: n x n heightfield of filled columns (value noise, 3 octaves)
+--------------------------------------------------------------------------------
+local function hash2(x, y, seed)
+  local h = (x * 374761393 + y * 668265263 + seed * 144665) & 0xFFFFFFFF
+  h = ((h ~ (h >> 13)) * 1274126177) & 0xFFFFFFFF
+  return ((h ~ (h >> 16)) & 0xFFFF) / 0xFFFF
+end
+
+local function valueNoise(x, y, seed)
+  local x0, y0 = math.floor(x), math.floor(y)
+  local fx, fy = x - x0, y - y0
+  fx, fy = fx * fx * (3 - 2 * fx), fy * fy * (3 - 2 * fy)
+  local a = hash2(x0, y0, seed) + (hash2(x0 + 1, y0, seed) - hash2(x0, y0, seed)) * fx
+  local b = hash2(x0, y0 + 1, seed) + (hash2(x0 + 1, y0 + 1, seed) - hash2(x0, y0 + 1, seed)) * fx
+  return a + (b - a) * fy
+end
+
+function fixtures.terrain(n, seed)
+  seed = seed or 1
+  local out = {}
+  local maxH = math.max(1, n // 2)
+  for y = 0, n - 1 do
+    for x = 0, n - 1 do
+      local h, amp, freq = 0, 0.5, 4 / n
+      for _ = 1, 3 do
+        h = h + amp * valueNoise(x * freq, y * freq, seed)
+        amp, freq = amp * 0.5, freq * 2
+      end
+      local top = math.max(1, math.floor(h / 0.875 * maxH))
+      for z = 0, top - 1 do
+        local t = z / maxH
+        out[#out + 1] = voxel(x, y, z, math.floor(60 + 150 * t), math.floor(160 - 60 * t), 70)
+      end
+    end
+  end
+  return out
+end
+
+--------------------------------------------------------------------------------
+-- Sprite stack from raw RGBA slices: width*height*4 bytes per slice, slices
+-- back to back; slice i becomes z = i (as layers do in the voxel generator).
+--------------------------------------------------------------------------------
+function fixtures.spriteStack(path, width, height)
+  local f, err = io.open(path, "rb")
+  if not f then return nil, err end
+  local data = f:read("a")
+  f:close()
+  local sliceBytes = width * height * 4
+  if sliceBytes == 0 or #data % sliceBytes ~= 0 then
+    return nil, string.format("%s: %d bytes is not a multiple of %dx%dx4", path, #data, width, height)
+  end
+  local out = {}
+  for z = 0, #data // sliceBytes - 1 do
+    local base = z * sliceBytes
+    for y = 0, height - 1 do
+      for x = 0, width - 1 do
+        local i = base + (y * width + x) * 4 + 1
+        local r, g, b, a = data:byte(i, i + 3)
+        if a > 0 then
+          out[#out + 1] = { x = x, y = y, z = z + 1, color = { r = r, g = g, b = b, a = a } }
+        end
+      end
+    end
+  end
+  return out
+end
+
+--------------------------------------------------------------------------------
+-- Surface voxels only (at least one empty 6-neighbor), mirroring the shell
+-- brick_cache hands to the native renderer for opaque models
+--------------------------------------------------------------------------------
+function fixtures.shell(voxels)
+  local occ = {}
+  local function key(x, y, z) return x .. "," .. y .. "," .. z end
+  for _, v in ipairs(voxels) do occ[key(v.x, v.y, v.z)] = true end
+  local out = {}
+  for _, v in ipairs(voxels) do
+    local x, y, z = v.x, v.y, v.z
+    if not (occ[key(x + 1, y, z)] and occ[key(x - 1, y, z)] and occ[key(x, y + 1, z)]
+        and occ[key(x, y - 1, z)] and occ[key(x, y, z + 1)] and occ[key(x, y, z - 1)]) then
+      out[#out + 1] = v
+    end
+  end
+  return out
+end
+
+fixtures.GENERATORS = { "cube", "sphere", "menger", "terrain" }
+
+return fixtures
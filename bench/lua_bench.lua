@@ -0,0 +1,193 @@
+-- lua_bench.lua
+-- Benchmarks the pure-Lua paths most users run (no native module): voxel
+-- generation, previewRenderer.renderVoxelModel -> renderPreview and the
+-- exporters, headless under stock lua5.4 with bench/aseprite_mock.lua.
+-- Per-stage times come from the renderer's own performanceProfiler
+-- sections (enableProfiling), so numbers match the Debug tab breakdown.
+--
+--   lua5.4 bench/lua_bench.lua [--fixtures cube,sphere,menger,terrain]
+--     [--sizes 8,16] [--canvas 128] [--modes basic,stack,dynamic]
+--     [--rotations 0:0:0,30:45:0] [--iterations 10] [--warmup 2]
+--     [--stages generate,render,export] [--out results.json]
+--
+-- Times are os.clock() CPU milliseconds.
+
+local src = debug.getinfo(1, "S").source:gsub("^@", "")
+local benchDir = src:match("^(.*)[/\\]") or "."
+local benchUtil = dofile(benchDir .. "/bench_util.lua")
+local fixtures = dofile(benchDir .. "/fixtures.lua")
+local mock = dofile(benchDir .. "/aseprite_mock.lua")
+
+local opts = benchUtil.parseArgs(arg, {
+  fixtures = "cube,sphere,menger,terrain",
+  sizes = "8,16",
+  canvas = "128",
+  modes = "basic,stack,dynamic",
+  rotations = "0:0:0,30:45:0",
+  iterations = "10",
+  warmup = "2",
+  stages = "generate,render,export"
+})
+
+--------------------------------------------------------------------------------
+-- Load the extension against the mock (quietly, Lua backends only)
+--------------------------------------------------------------------------------
+mock.install()
+do
+  local print0 = print
+  print = function() end
+  dofile(benchUtil.path("loader.lua"))
+  print = print0
+end
+AseVoxel.render.native_bridge.setForceDisabled(true)
+
+local previewRenderer = AseVoxel.previewRenderer
+local voxelGenerator = AseVoxel.render.voxel_generator
+local timelineCache = AseVoxel.render.timeline_cache
+local profiler = AseVoxel.utils.performance_profiler
+local iterations = tonumber(opts.iterations)
+local warmup = tonumber(opts.warmup)
+profiler._maxSamples = iterations
+
+local stages = {}
+for _, s in ipairs(benchUtil.list(opts.stages)) do stages[s] = true end
+
+local function nowMs() return os.clock() * 1000 end
+
+-- Runs fn warmup + iterations times and records the measured runs as
+-- section name of profile id
+local function measure(id, name, fn)
+  for _ = 1, warmup do fn() end
+  local samples = {}
+  for i = 1, iterations do
+    local t0 = nowMs()
+    fn()
+    samples[i] = nowMs() - t0
+  end
+  profiler.startProfile(id)
+  for _, ms in ipairs(samples) do profiler.record(name, ms) end
+  profiler.endProfile()
+end
+
+local MODES = { basic = "Basic", stack = "Stack", dynamic = "Dynamic" }
+
+local function renderParams(mode, canvas, size, rot)
+  local p = {
+    width = canvas, height = canvas,
+    scaleLevel = math.max(1, canvas / (size * 1.8)),
+    xRotation = rot.x, yRotation = rot.y, zRotation = rot.z,
+    shadingMode = MODES[mode] or mode,
+    basicShadeIntensity = 50, basicLightIntensity = 50,
+    backgroundColor = Color(0, 0, 0, 0),
+    enableProfiling = true,
+    noFrameCache = true
+  }
+  if p.shadingMode == "Stack" then
+    p.fxStack = AseVoxel.render.fx_stack.makeDefaultStack()
+  elseif p.shadingMode == "Dynamic" then
+    p.lighting = {
+      pitch = 25, yaw = 25, diffuse = 60, diameter = 100,
+      ambient = 30, lightColor = Color(255, 255, 255), rimEnabled = true
+    }
+  end
+  return p
+end
+
+--------------------------------------------------------------------------------
+-- Sweep
+--------------------------------------------------------------------------------
+local cases = {}
+local tmpDir = os.getenv("TMPDIR") or (benchUtil.sep == "\\" and os.getenv("TEMP")) or "/tmp"
+
+local function addCase(c)
+  cases[#cases + 1] = c
+  local call = c.stats.call or c.stats.obj
+  benchUtil.log("%-40s median %8.2f ms  p95 %8.2f ms", c.id, call and call.median or 0, call and call.p95 or 0)
+end
+
+for _, name in ipairs(benchUtil.list(opts.fixtures)) do
+  local gen = fixtures[name]
+  if not gen then error("unknown fixture: " .. name) end
+  for _, size in ipairs(benchUtil.list(opts.sizes, true)) do
+    local voxels = gen(size)
+    local sprite = mock.spriteFromVoxels(voxels)
+    app.activeSprite = sprite
+    local base = name .. "-" .. size
+
+    if stages.generate then
+      -- Cold: every call re-voxelizes; warm: timeline cache hit
+      local id = base .. "/generate"
+      profiler.clear(id)
+      measure(id, "call", function()
+        timelineCache.invalidate()
+        voxelGenerator.generateVoxelModel(sprite)
+      end)
+      measure(id, "cached", function() voxelGenerator.generateVoxelModel(sprite) end)
+      addCase({ id = id, fixture = name, size = size, voxels = #voxels, stage = "generate",
+                stats = benchUtil.sectionStats(profiler, id) })
+    end
+
+    local model = voxelGenerator.generateVoxelModel(sprite)
+    local lastImage
+
+    if stages.render then
+      for _, canvas in ipairs(benchUtil.list(opts.canvas, true)) do
+        for _, mode in ipairs(benchUtil.list(opts.modes)) do
+          for _, rot in ipairs(benchUtil.rotations(opts.rotations)) do
+            local id = string.format("%s/%d/%s/%g:%g:%g", base, canvas, mode, rot.x, rot.y, rot.z)
+            local metrics
+            profiler.clear("renderPreview")
+            profiler.clear("renderVoxelModel")
+            profiler.clear(id)
+            measure(id, "call", function()
+              local p = renderParams(mode, canvas, size, rot)
+              p.metrics = {}
+              lastImage = previewRenderer.renderVoxelModel(model, p)
+              metrics = p.metrics
+            end)
+            -- Renderer sections (bounds, transform_and_sort, draw_loop, ...)
+            local stats = benchUtil.sectionStats(profiler, id)
+            for section, s in pairs(benchUtil.sectionStats(profiler, "renderPreview")) do
+              stats[section] = s
+            end
+            addCase({
+              id = id, fixture = name, size = size, voxels = #model, stage = "render",
+              canvas = canvas, mode = mode, rotation = rot, backend = metrics and metrics.backend,
+              counters = metrics and {
+                facesDrawn = metrics.facesDrawn, facesBackfaced = metrics.facesBackfaced,
+                facesCulledAdj = metrics.facesCulledAdj, shellVoxels = metrics.shellVoxels,
+                drawAllocKB = metrics.drawAllocKB
+              },
+              stats = stats
+            })
+          end
+        end
+      end
+    end
+
+    if stages.export then
+      local id = base .. "/export"
+      profiler.clear(id)
+      local path = tmpDir .. benchUtil.sep .. "asevoxel_bench"
+      measure(id, "obj", function() AseVoxel.io.export_obj.export(model, path .. ".obj", {}) end)
+      measure(id, "ply", function() AseVoxel.io.export_ply.export(model, path .. ".ply", {}) end)
+      measure(id, "stl", function() AseVoxel.io.export_stl.export(model, path .. ".stl", {}) end)
+      if lastImage then
+        measure(id, "png", function() AseVoxel.io.export_turntable.writePNG(lastImage, path .. ".png") end)
+      end
+      for _, ext in ipairs({ ".obj", ".ply", ".stl", ".png" }) do os.remove(path .. ext) end
+      os.remove(tmpDir .. benchUtil.sep .. "voxel_export.mtl")
+      local stats = benchUtil.sectionStats(profiler, id)
+      addCase({ id = id, fixture = name, size = size, voxels = #model, stage = "export",
+                stats = stats })
+    end
+  end
+end
+
+benchUtil.emit({
+  tool = "lua_bench",
+  lua = _VERSION,
+  iterations = iterations,
+  warmup = warmup,
+  cases = cases
+}, opts.out)
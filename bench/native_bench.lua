@@ -0,0 +1,273 @@
+-- native_bench.lua
+-- Headless throughput benchmark for the native renderer. Runs under stock
+-- lua5.4 outside Aseprite: loads asevoxel_native (render/bin by default),
+-- renders procedural fixtures across a sweep of model size, canvas size,
+-- shading mode and rotation, and writes JSON with per-case percentiles.
+--
+--   lua5.4 bench/native_bench.lua [--fixtures cube,sphere,menger,terrain]
+--     [--sizes 8,16,32] [--canvas 128,256] [--modes basic,stack,dynamic]
+--     [--rotations 0:0:0,30:45:0] [--iterations 20] [--warmup 3]
+--     [--stack slices.raw --stack-size 32x32] [--no-shell] [--scale N]
+--     [--perf] [--module path/to/asevoxel_native.so] [--out results.json]
+--
+-- "call_cpu" is os.clock() time around each render_* call: CPU time, summed
+-- across threads on multi-threaded builds, so it is not latency. Builds that
+-- return result.metrics also report their own monotonic per-stage timings as
+-- native_<stage> sections, "native_total" (metrics.total_ms, else the stage
+-- sum) and the faces/pixels/overdraw counters. voxelsPerSec comes from
+-- native_total; without module metrics only voxelsPerCpuSec is reported.
+--
+-- --perf adds hardware counters per case (cycles, instructions, L1/LLC and
+-- branch misses, IPC, misses per 1000 instructions). Builds that honor
+-- params.perfCounters return them per stage and per worker thread in
+-- result.metrics.perf / perf_threads; otherwise each case is re-run under
+-- `perf stat` (bench/perf_counters.lua) for whole-call counts.
+
+local src = debug.getinfo(1, "S").source:gsub("^@", "")
+local benchDir = src:match("^(.*)[/\\]") or "."
+local benchUtil = dofile(benchDir .. "/bench_util.lua")
+local fixtures = dofile(benchDir .. "/fixtures.lua")
+local perfCounters = dofile(benchDir .. "/perf_counters.lua")
+
+local opts = benchUtil.parseArgs(arg, {
+  fixtures = "cube,sphere,menger,terrain",
+  sizes = "8,16,32",
+  canvas = "128,256",
+  modes = "basic,stack,dynamic",
+  rotations = "0:0:0,30:45:0",
+  iterations = "20",
+  warmup = "3",
+  scale = "auto"
+})
+
+local NATIVE_STAGES = { "parse", "transform", "cull", "raster", "shade", "outline", "downsample" }
+
+--------------------------------------------------------------------------------
+-- Module
+--------------------------------------------------------------------------------
+local function loadNative()
+  if opts.module then
+    local open, err = package.loadlib(opts.module, "luaopen_asevoxel_native")
+    if not open then return nil, err end
+    return open(), opts.module
+  end
+  local bin = benchUtil.path("render", "bin") .. benchUtil.sep
+  package.cpath = bin .. "?.so;" .. bin .. "?.dll;" .. package.cpath
+  local ok, mod = pcall(require, "asevoxel_native")
+  if not ok then return nil, mod end
+  return mod, package.searchpath("asevoxel_native", package.cpath) or "(require)"
+end
+
+local native, modulePath = loadNative()
+if type(native) ~= "table" then
+  benchUtil.log("asevoxel_native not loadable: %s", tostring(modulePath))
+  benchUtil.log("build it with ./create_extension.sh -k (or pass --module <path>)")
+  os.exit(1)
+end
+
+local fxStack = benchUtil.load("render/fx_stack")
+
+--------------------------------------------------------------------------------
+-- Request packaging (same layout previewRenderer sends to render_*)
+--------------------------------------------------------------------------------
+local function flatten(model)
+  local flat = {}
+  for i, v in ipairs(model) do
+    local c = v.color
+    flat[i] = { v.x, v.y, v.z, c.r, c.g, c.b, c.a }
+  end
+  return flat
+end
+
+local function nativeParams(mode, canvas, size, rot)
+  local scale = tonumber(opts.scale) or math.max(1, canvas / (size * 1.8))
+  local p = {
+    width = canvas, height = canvas,
+    xRotation = rot.x, yRotation = rot.y, zRotation = rot.z,
+    scale = scale,
+    orthogonal = false,
+    basicShadeIntensity = 50,
+    basicLightIntensity = 50,
+    perspectiveScaleRef = "middle",
+    backgroundColor = { r = 0, g = 0, b = 0, a = 0 },
+    perfCounters = opts.perf and true or nil
+  }
+  if mode == "stack" then
+    p.fxStack = fxStack.makeDefaultStack()
+  elseif mode == "dynamic" then
+    p.lighting = {
+      pitch = 25, yaw = 25, diffuse = 60, diameter = 100, ambient = 30,
+      rimEnabled = false, lightColor = { r = 255, g = 255, b = 255 }
+    }
+  end
+  return p
+end
+
+--------------------------------------------------------------------------------
+-- Models
+--------------------------------------------------------------------------------
+local models = {}
+for _, name in ipairs(benchUtil.list(opts.fixtures)) do
+  local gen = fixtures[name]
+  if not gen then error("unknown fixture: " .. name) end
+  for _, size in ipairs(benchUtil.list(opts.sizes, true)) do
+    models[#models + 1] = { fixture = name, size = size, voxels = gen(size) }
+  end
+end
+if opts.stack then
+  local w, h = tostring(opts.stackSize or ""):match("^(%d+)x(%d+)$")
+  if not w then error("--stack needs --stack-size WxH") end
+  local voxels = assert(fixtures.spriteStack(opts.stack, tonumber(w), tonumber(h)))
+  models[#models + 1] = { fixture = "stack:" .. opts.stack, size = math.max(tonumber(w), tonumber(h)), voxels = voxels, stack = true }
+end
+
+--------------------------------------------------------------------------------
+-- Hardware counters
+--------------------------------------------------------------------------------
+local iterations = tonumber(opts.iterations)
+local warmup = tonumber(opts.warmup)
+
+-- Sums module-reported counter tables: into[name][key] += value
+local function addCounters(into, name, c)
+  if type(c) ~= "table" then return end
+  local t = into[name] or {}
+  into[name] = t
+  for _, e in ipairs(perfCounters.EVENTS) do
+    local v = tonumber(c[e[2]])
+    if v then t[e[2]] = (t[e[2]] or 0) + v end
+  end
+end
+
+local function averaged(sums, n)
+  local out = {}
+  for name, c in pairs(sums) do
+    local avg = {}
+    for k, v in pairs(c) do avg[k] = v / n end
+    out[name] = perfCounters.derive(avg)
+  end
+  return out
+end
+
+-- Re-runs one case in a child process under perf stat (with and without
+-- iterations) and returns per-call counters, or nil
+local function externalCounters(m, canvas, mode, rot)
+  if opts.perfChild or not perfCounters.available() then return nil end
+  local interp, script = arg[-1], arg[0]
+  local function argv(n)
+    local a = { interp, script,
+      "--canvas", tostring(canvas), "--modes", mode,
+      "--rotations", string.format("%g:%g:%g", rot.x, rot.y, rot.z),
+      "--iterations", tostring(n), "--warmup", tostring(warmup),
+      "--scale", tostring(opts.scale), "--perf-child", "--out", "/dev/null" }
+    if m.stack then
+      a[#a + 1] = "--fixtures"; a[#a + 1] = ","
+      a[#a + 1] = "--stack"; a[#a + 1] = opts.stack
+      a[#a + 1] = "--stack-size"; a[#a + 1] = opts.stackSize
+    else
+      a[#a + 1] = "--fixtures"; a[#a + 1] = m.fixture
+      a[#a + 1] = "--sizes"; a[#a + 1] = tostring(m.size)
+    end
+    if opts.module then a[#a + 1] = "--module"; a[#a + 1] = opts.module end
+    if opts.noShell then a[#a + 1] = "--no-shell" end
+    return a
+  end
+  local with, err = perfCounters.run(argv(iterations))
+  local base = with and perfCounters.run(argv(0))
+  if not (with and base) then
+    benchUtil.log("perf stat unavailable: %s", tostring(err))
+    return nil
+  end
+  return perfCounters.perIteration(with, base, iterations)
+end
+
+--------------------------------------------------------------------------------
+-- Sweep
+--------------------------------------------------------------------------------
+local profiler = benchUtil.newProfiler(iterations)
+local cases = {}
+
+for _, m in ipairs(models) do
+  local source = opts.noShell and m.voxels or fixtures.shell(m.voxels)
+  local flat = flatten(source)
+  for _, canvas in ipairs(benchUtil.list(opts.canvas, true)) do
+    for _, mode in ipairs(benchUtil.list(opts.modes)) do
+      local fn = native["render_" .. mode]
+      for _, rot in ipairs(benchUtil.rotations(opts.rotations)) do
+        local id = string.format("%s-%d/%d/%s/%g:%g:%g", m.fixture, m.size, canvas, mode, rot.x, rot.y, rot.z)
+        if not fn then
+          benchUtil.log("skip %s (module has no render_%s)", id, mode)
+        else
+          local params = nativeParams(mode, canvas, m.size, rot)
+          for _ = 1, warmup do fn(flat, params) end
+          profiler.clear(id)
+          profiler.startProfile(id)
+          local counters
+          local stagePerf, threadPerf = {}, {}
+          for _ = 1, iterations do
+            profiler.mark("call_cpu")
+            local res = fn(flat, params)
+            profiler.measure("call_cpu")
+            local nm = type(res) == "table" and res.metrics
+            if type(nm) == "table" then
+              local total = 0
+              for _, stage in ipairs(NATIVE_STAGES) do
+                local ms = nm[stage .. "_ms"]
+                profiler.record("native_" .. stage, ms)
+                total = total + (tonumber(ms) or 0)
+              end
+              profiler.record("native_total", tonumber(nm.total_ms) or total)
+              counters = { faces_drawn = nm.faces_drawn, pixels_written = nm.pixels_written, overdraw = nm.overdraw }
+              for stage, c in pairs(type(nm.perf) == "table" and nm.perf or {}) do
+                addCounters(stagePerf, stage, c)
+              end
+              for i, c in ipairs(type(nm.perf_threads) == "table" and nm.perf_threads or {}) do
+                addCounters(threadPerf, i, c)
+              end
+            end
+          end
+          profiler.endProfile()
+          local perf
+          if opts.perf then
+            if next(stagePerf) then
+              local threads = {}
+              for i, c in pairs(averaged(threadPerf, iterations)) do threads[i] = c end
+              perf = { source = "module", stages = averaged(stagePerf, iterations), threads = threads }
+            else
+              local call = externalCounters(m, canvas, mode, rot)
+              perf = call and { source = "perf stat", call = call }
+            end
+          end
+          local stats = benchUtil.sectionStats(profiler, id)
+          local cpu = stats.call_cpu and stats.call_cpu.median or 0
+          local wall = stats.native_total and stats.native_total.median or 0
+          cases[#cases + 1] = {
+            id = id,
+            fixture = m.fixture, size = m.size,
+            voxels = #m.voxels, renderedVoxels = #source,
+            canvas = canvas, mode = mode, rotation = rot,
+            stats = stats,
+            counters = counters,
+            perf = perf,
+            voxelsPerSec = wall > 0 and #source / (wall / 1000) or nil,
+            voxelsPerCpuSec = cpu > 0 and #source / (cpu / 1000) or nil
+          }
+          local ipc = perf and perf.call and perf.call.ipc
+          local timing = (wall > 0)
+            and string.format("native median %8.2f ms  p95 %8.2f ms", wall, stats.native_total.p95)
+            or string.format("cpu median %8.2f ms  p95 %8.2f ms", cpu, stats.call_cpu and stats.call_cpu.p95 or 0)
+          benchUtil.log("%-40s %s%s", id, timing, ipc and string.format("  IPC %.2f", ipc) or "")
+        end
+      end
+    end
+  end
+end
+
+benchUtil.emit({
+  tool = "native_bench",
+  module = modulePath,
+  lua = _VERSION,
+  iterations = iterations,
+  warmup = warmup,
+  shell = not opts.noShell,
+  cases = cases
+}, opts.out)
@@ -0,0 +1,88 @@
+-- perf_counters.lua
+-- Linux hardware counters for the benchmark runners, read through
+-- `perf stat` (the perf_event_open front end; needs linux-tools and
+-- kernel.perf_event_paranoid <= 2 for user-space counting). Lua has no
+-- syscall access of its own, so a measured case runs in a child process:
+-- once with N iterations and once with none, and the difference divided by
+-- N is the per-iteration cost with module load, fixture setup and warmup
+-- cancelled out.
+
+local perfCounters = {}
+
+-- perf event -> result key
+perfCounters.EVENTS = {
+  { "cycles", "cycles" },
+  { "instructions", "instructions" },
+  { "L1-dcache-load-misses", "l1d_misses" },
+  { "LLC-load-misses", "llc_misses" },
+  { "branch-misses", "branch_misses" }
+}
+
+local function shellQuote(s)
+  return "'" .. tostring(s):gsub("'", "'\\''") .. "'"
+end
+
+local _available
+function perfCounters.available()
+  if _available == nil then
+    _available = false
+    if package.config:sub(1, 1) == "/" then
+      _available = os.execute("perf --version >/dev/null 2>&1") == true
+    end
+  end
+  return _available
+end
+
+-- Runs argv (array of words) under perf stat; returns { key = count } with
+-- nil for events the CPU/kernel would not count, or nil, err
+function perfCounters.run(argv)
+  local tmp = os.tmpname()
+  local names = {}
+  for i, e in ipairs(perfCounters.EVENTS) do names[i] = e[1] end
+  local words = {}
+  for i, w in ipairs(argv) do words[i] = shellQuote(w) end
+  local cmd = string.format("perf stat -x, -o %s -e %s -- %s >/dev/null 2>&1",
+    shellQuote(tmp), table.concat(names, ","), table.concat(words, " "))
+  local ok = os.execute(cmd)
+  local f = io.open(tmp, "r")
+  local text = f and f:read("a") or ""
+  if f then f:close() end
+  os.remove(tmp)
+  if not ok then return nil, "perf stat failed: " .. cmd end
+  local counts = {}
+  for line in text:gmatch("[^\n]+") do
+    -- value,unit,event,run time,percentage,...
+    local value, event = line:match("^([^,]*),[^,]*,([^,]+)")
+    if value and event then
+      event = event:gsub(":u$", "")
+      for _, e in ipairs(perfCounters.EVENTS) do
+        if e[1] == event then counts[e[2]] = tonumber(value) end
+      end
+    end
+  end
+  return counts
+end
+
+-- (with - base) / n per key, plus derived ratios
+function perfCounters.perIteration(with, base, n)
+  local out = {}
+  for _, e in ipairs(perfCounters.EVENTS) do
+    local k = e[2]
+    if with[k] and base[k] and n > 0 then out[k] = math.max(0, (with[k] - base[k]) / n) end
+  end
+  return perfCounters.derive(out)
+end
+
+-- Adds ipc and misses per 1000 instructions where the inputs exist
+function perfCounters.derive(c)
+  local instr = c.instructions
+  if instr and instr > 0 then
+    if c.cycles and c.cycles > 0 then c.ipc = instr / c.cycles end
+    if c.l1d_misses then c.l1d_mpki = c.l1d_misses * 1000 / instr end
+    if c.llc_misses then c.llc_mpki = c.llc_misses * 1000 / instr end
+    if c.branch_misses then c.branch_mpki = c.branch_misses * 1000 / instr end
+  end
+  return c
+end
+
+return perfCounters
@@ -0,0 +1,166 @@
+-- replay.lua
+-- Replays a session recorded from the Debug tab ("Record Session",
+-- core/session_recorder.lua) against the renderer, headless under stock
+-- lua5.4 with bench/aseprite_mock.lua, and reports latency distributions
+-- per request source and overall. Only the requests the viewer actually
+-- rendered are replayed by default; --all replays coalesced ones as well.
+--
+--   lua5.4 bench/replay.lua session.lua [--all] [--no-cache] [--native]
+--     [--iterations 1] [--module path/to/asevoxel_native.so] [--out results.json]
+--
+-- Times are os.clock() CPU milliseconds around previewRenderer.renderVoxelModel,
+-- with the params the viewer would have built (viewerCore.buildRenderParams).
+-- The frame cache stays on unless --no-cache, as in the viewer.
+
+local src = debug.getinfo(1, "S").source:gsub("^@", "")
+local benchDir = src:match("^(.*)[/\\]") or "."
+local benchUtil = dofile(benchDir .. "/bench_util.lua")
+local mock = dofile(benchDir .. "/aseprite_mock.lua")
+
+local sessionPath = arg[1]
+if not sessionPath or sessionPath:match("^%-%-") then
+  benchUtil.log("usage: lua5.4 bench/replay.lua session.lua [--all] [--no-cache] [--native] [--iterations N] [--out f.json]")
+  os.exit(1)
+end
+local opts = benchUtil.parseArgs({ table.unpack(arg, 2) }, { iterations = "1" })
+
+--------------------------------------------------------------------------------
+-- Load the extension against the mock (quietly)
+--------------------------------------------------------------------------------
+mock.install()
+do
+  local print0 = print
+  print = function() end
+  dofile(benchUtil.path("loader.lua"))
+  print = print0
+end
+local nativeBridge = AseVoxel.render.native_bridge
+if opts.native then
+  if opts.module then
+    local open, err = package.loadlib(opts.module, "luaopen_asevoxel_native")
+    if not open then benchUtil.log("cannot load %s: %s", opts.module, tostring(err)); os.exit(1) end
+    package.loaded["asevoxel_native"] = open()
+  end
+else
+  nativeBridge.setForceDisabled(true)
+end
+
+local previewRenderer = AseVoxel.previewRenderer
+local viewerCore = AseVoxel.viewerCore
+local frameCache = AseVoxel.render.frame_cache
+
+--------------------------------------------------------------------------------
+-- Session file
+--------------------------------------------------------------------------------
+local models, events = {}, {}
+local version
+
+local env = {
+  V = function(v) version = v end,
+  M = function(key, count, packed)
+    local model, pos = {}, 1
+    for i = 1, count do
+      local x, y, z, r, g, b, a
+      x, y, z, r, g, b, a, pos = string.unpack("<i2i2i2BBBB", packed, pos)
+      model[i] = { x = x, y = y, z = z, color = { r = r, g = g, b = b, a = a } }
+    end
+    models[key] = model
+  end,
+  E = function(e) events[#events + 1] = e end,
+  C = Color
+}
+
+do
+  local f, err = io.open(sessionPath, "rb")
+  if not f then benchUtil.log("cannot open %s: %s", sessionPath, tostring(err)); os.exit(1) end
+  local text = f:read("a")
+  f:close()
+  -- A session cut short (viewer closed while recording) keeps its complete lines
+  local chunk, loadErr = load(text, "=" .. sessionPath, "t", env)
+  if not chunk then
+    local lines = {}
+    for line in text:gmatch("[^\n]*") do lines[#lines + 1] = line end
+    for n = #lines - 1, 1, -1 do
+      chunk = load(table.concat(lines, "\n", 1, n), "=" .. sessionPath, "t", env)
+      if chunk then break end
+    end
+  end
+  if not chunk then benchUtil.log("bad session file: %s", tostring(loadErr)); os.exit(1) end
+  chunk()
+end
+if version ~= 1 then
+  benchUtil.log("unsupported session version %s", tostring(version))
+  os.exit(1)
+end
+
+--------------------------------------------------------------------------------
+-- Replay
+--------------------------------------------------------------------------------
+local iterations = tonumber(opts.iterations) or 1
+local total = 0
+for _, e in ipairs(events) do
+  if (opts.all or e.rendered) and models[e.model] then total = total + 1 end
+end
+local profiler = benchUtil.newProfiler(math.max(1, total * iterations))
+profiler.clear("replay")
+
+local STAGES = { "t_transformSort_ms", "t_draw_ms", "t_outline_ms", "t_downsample_ms" }
+local backends = {}
+local skipped = 0
+
+local function nowMs() return os.clock() * 1000 end
+
+profiler.startProfile("replay")
+for _ = 1, iterations do
+  if opts.noCache then frameCache.clear() end
+  for _, e in ipairs(events) do
+    local model = models[e.model]
+    if not (opts.all or e.rendered) then
+      -- coalesced by the scheduler; not replayed
+    elseif not model then
+      skipped = skipped + 1
+    else
+      local p = viewerCore.buildRenderParams(e.params)
+      p.width, p.height = e.params.width, e.params.height
+      p.backgroundColor = e.params.backgroundColor
+      p.noFrameCache = opts.noCache or nil
+      p.metrics = {}
+      local t0 = nowMs()
+      previewRenderer.renderVoxelModel(model, p)
+      local ms = nowMs() - t0
+      profiler.record("all", ms)
+      profiler.record("source." .. tostring(e.source), ms)
+      for _, k in ipairs(STAGES) do
+        if p.metrics[k] then profiler.record((k:gsub("^t_", ""):gsub("_ms$", "")), p.metrics[k]) end
+      end
+      local backend = p.metrics.backend or "unknown"
+      backends[backend] = (backends[backend] or 0) + 1
+    end
+  end
+end
+profiler.endProfile()
+
+local modelCount = 0
+for _ in pairs(models) do modelCount = modelCount + 1 end
+local stats = benchUtil.sectionStats(profiler, "replay")
+local all = stats.all
+benchUtil.log("%s: %d events, %d models, %d replayed x%d", sessionPath, #events, modelCount, total, iterations)
+if all then
+  benchUtil.log("median %8.2f ms  p95 %8.2f ms  p99 %8.2f ms  max %8.2f ms",
+    all.median or 0, all.p95 or 0, all.p99 or 0, all.max or 0)
+end
+
+benchUtil.emit({
+  tool = "replay",
+  session = sessionPath,
+  lua = _VERSION,
+  native = opts.native and true or false,
+  frameCache = not opts.noCache,
+  iterations = iterations,
+  events = #events,
+  models = modelCount,
+  replayed = total,
+  skipped = skipped,
+  backends = backends,
+  stats = stats
+}, opts.out)
@@ -0,0 +1,109 @@
+-- scheduler_check.lua
+-- Headless regression check for viewerCore's async job handling, run
+-- against a scripted stand-in for the native module's job API:
+--   * a finished job renders through the worker and async stays on;
+--   * a job whose pixel buffer does not decode disables async rendering
+--     (the frame is redone inline, later frames skip the worker).
+--
+--   lua5.4 bench/scheduler_check.lua
+--
+-- Prints one line per case and exits non-zero when any case fails.
+
+local src = debug.getinfo(1, "S").source:gsub("^@", "")
+local benchDir = src:match("^(.*)[/\\]") or "."
+local benchUtil = dofile(benchDir .. "/bench_util.lua")
+local fixtures = dofile(benchDir .. "/fixtures.lua")
+local mock = dofile(benchDir .. "/aseprite_mock.lua")
+
+mock.install()
+
+-- Timers only tick when driven
+local timers = {}
+local Timer0 = Timer
+Timer = function(opts)
+  local t = Timer0(opts)
+  timers[#timers + 1] = t
+  return t
+end
+local function tickAll()
+  for _, t in ipairs(timers) do
+    if t.isRunning and t.ontick then t.ontick() end
+  end
+end
+
+-- Native stand-in: jobs finish on their second poll; "malformed" hands back
+-- a pixel string one byte short
+local resultMode = "ok"
+local submitted = 0
+package.preload["asevoxel_native"] = function()
+  local m = {}
+  local function frame(p, short)
+    local bytes = string.rep("\255\0\0\255", p.width * p.height)
+    if short then bytes = bytes:sub(2) end
+    return { width = p.width, height = p.height, pixels = bytes }
+  end
+  m.render_basic = function(_, p) return frame(p) end
+  m.render_stack = m.render_basic
+  m.submit_render = function(_, p)
+    submitted = submitted + 1
+    local h = { polls = 0 }
+    function h:poll() self.polls = self.polls + 1; return self.polls >= 2 end
+    function h:cancel() end
+    function h:result() return frame(p, resultMode == "malformed") end
+    return h
+  end
+  return m
+end
+
+do
+  local print0 = print
+  print = function() end
+  dofile(benchUtil.path("loader.lua"))
+  AseVoxel.render.native_bridge._mod = require("asevoxel_native")
+  print = print0
+end
+
+local viewerCore = AseVoxel.viewerCore
+local sched = viewerCore._sched
+sched.specEnabled, sched.timelineEnabled = false, false
+app.activeSprite = mock.spriteFromVoxels(fixtures.sphere(6))
+
+local dlg = { repaint = function() end }
+local function request(rot)
+  local got
+  local params = { xRotation = rot, yRotation = 0, zRotation = 0, scaleLevel = 1,
+                   shadingMode = "Basic", width = 40, height = 40 }
+  local print0 = print
+  print = function() end
+  viewerCore.requestPreview(dlg, params, nil, "ui", function(r) got = r end)
+  for _ = 1, 4 do tickAll() end
+  print = print0
+  return got
+end
+
+local failures = 0
+local function check(name, ok, detail)
+  print(string.format("%-40s %s  %s", name, ok and "ok" or "FAIL", detail))
+  if not ok then failures = failures + 1 end
+end
+
+local before = submitted
+local r = request(10)
+check("worker frame keeps async on",
+  r and r.image and submitted == before + 1 and not sched.asyncDisabled,
+  string.format("jobs=%d asyncDisabled=%s", submitted - before, tostring(sched.asyncDisabled)))
+
+resultMode = "malformed"
+before = submitted
+r = request(20)
+check("malformed buffer disables async",
+  r and r.image and sched.asyncDisabled == true,
+  string.format("jobs=%d asyncDisabled=%s", submitted - before, tostring(sched.asyncDisabled)))
+
+before = submitted
+r = request(30)
+check("later frames skip the worker",
+  r and r.image and submitted == before,
+  string.format("jobs=%d", submitted - before))
+
+os.exit(failures == 0 and 0 or 1)
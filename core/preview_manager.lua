@@ -17,6 +17,10 @@ local function getRotation()
   return AseVoxel.math.rotation
 end
 
+local function getTelemetry()
+  return AseVoxel.utils.telemetry
+end
+
 viewerCore._sched = {
   renderingInProgress = false,
   pendingParams = nil,
@@ -30,8 +34,7 @@ viewerCore._sched = {
   sampleIntervalMs = 100,             -- adaptive interval (ms)
 
   -- Adaptive timing
-  renderTimes = {},        -- recent render durations (ms)
-  maxSamples = 50,
+  maxSamples = 50,         -- telemetry window for the throttle's p75
   dynamicEnabled = true,
   dynamicMinMs = 40,       -- lower clamp
   dynamicMaxMs = 440,      -- upper clamp
@@ -41,32 +44,17 @@ viewerCore._sched = {
 -- Last render metrics snapshot
 viewerCore._lastMetrics = nil
 
--- Helper: insert render duration & update adaptive interval
+-- Helper: insert render duration & update adaptive interval (always-on
+-- telemetry histogram, separate from the viewer's "frame" metric)
 local function _recordRenderTime(ms)
   local s = viewerCore._sched
   if not s.dynamicEnabled or ms <= 0 then return end
-  local rt = s.renderTimes
-  rt[#rt+1] = ms
-  if #rt > s.maxSamples then
-    table.remove(rt, 1)
-  end
+  local telemetry = getTelemetry()
+  if not telemetry then return end
+  telemetry.metric("frame.watcher", s.maxSamples).window = s.maxSamples
+  telemetry.record("frame.watcher", ms)
   -- Patch 3.75.2: use 75th percentile instead of median (Option 2B)
-  local tmp = {}
-  for i,v in ipairs(rt) do tmp[i] = v end
-  table.sort(tmp)
-  local n = #tmp
-  local qIndexFloat = 0.75 * (n - 1) + 1     -- linear index (1-based)
-  local qLow = math.floor(qIndexFloat)
-  local qHigh = math.min(n, qLow + 1)
-  local frac = qIndexFloat - qLow
-  local qVal
-  if n == 0 then
-    qVal = ms
-  elseif qLow == qHigh then
-    qVal = tmp[qLow]
-  else
-    qVal = tmp[qLow] + (tmp[qHigh] - tmp[qLow]) * frac
-  end
+  local qVal = telemetry.percentile("frame.watcher", 0.75) or ms
   local desired = qVal * s.dynamicMultiplier
   if desired < s.dynamicMinMs then desired = s.dynamicMinMs end
   if desired > s.dynamicMaxMs then desired = s.dynamicMaxMs end
@@ -83,21 +71,15 @@ end
 
 function viewerCore.getAdaptiveStats()
   local s = viewerCore._sched
-  local count = #s.renderTimes
+  local telemetry = getTelemetry()
+  local count = telemetry and telemetry.count("frame.watcher") or 0
   if count == 0 then return {count=0, median=nil, p75=nil, interval=s.sampleIntervalMs} end
-  local tmp = {}
-  for i,v in ipairs(s.renderTimes) do tmp[i]=v end
-  table.sort(tmp)
-  local n = #tmp
-  local median = (n % 2 == 1) and tmp[(n+1)/2] or (tmp[n/2] + tmp[n/2+1]) / 2
-  local qIndexFloat = 0.75 * (n - 1) + 1
-  local qLow = math.floor(qIndexFloat)
-  local qHigh = math.min(n, qLow + 1)
-  local frac = qIndexFloat - qLow
-  local qVal
-  if qLow == qHigh then qVal = tmp[qLow]
-  else qVal = tmp[qLow] + (tmp[qHigh] - tmp[qLow]) * frac end
-  return {count=count, median=median, p75=qVal, interval=s.sampleIntervalMs}
+  return {
+    count = count,
+    median = telemetry.percentile("frame.watcher", 0.5),
+    p75 = telemetry.percentile("frame.watcher", 0.75),
+    interval = s.sampleIntervalMs
+  }
 end
 
 local function nowMs() return os.clock() * 1000 end
@@ -288,15 +270,14 @@ function viewerCore.calculateContrastColor(voxelModel)
   if not voxelModel or #voxelModel == 0 then
     return Color(128,128,128)
   end
-  local totalR,totalG,totalB,count = 0,0,0,0
-  for _,v in ipairs(voxelModel) do
-    local c = v.color
-    if c then
-      totalR = totalR + (c.r or 0)
-      totalG = totalG + (c.g or 0)
-      totalB = totalB + (c.b or 0)
-      count = count + 1
-    end
+  local buf = AseVoxel.render.voxel_buffer.of(voxelModel)
+  local rgba = buf.rgba
+  local totalR,totalG,totalB,count = 0,0,0,buf.n
+  for i = 1, count do
+    local c = rgba[i]
+    totalR = totalR + ((c >> 24) & 255)
+    totalG = totalG + ((c >> 16) & 255)
+    totalB = totalB + ((c >> 8) & 255)
   end
   if count == 0 then return Color(128,128,128) end
   local avgR,avgG,avgB = totalR/count,totalG/count,totalB/count
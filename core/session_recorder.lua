@@ -0,0 +1,175 @@
+-- session_recorder.lua
+-- Optional recorder of the viewer's render requests for replay-based
+-- performance runs (bench/replay.lua). Each viewerCore.requestPreview call
+-- is kept with its time, source and a snapshot of the view params; when the
+-- scheduler actually renders, the pending requests are tagged with the voxel
+-- model they saw (written once per distinct model) and streamed to the file.
+-- The last pending request before a render is marked rendered: coalesced
+-- ones are kept too, so a replay can choose either workload.
+--
+-- File format: a Lua chunk of V(), M(), E() calls, evaluated by the
+-- replayer in an environment that defines them (truncated files still load
+-- up to the last complete line).
+
+local sessionRecorder = {}
+
+local function getBrickCache()
+  return AseVoxel.render.brick_cache
+end
+
+local FORMAT_VERSION = 1
+
+local _rec = nil  -- { file, path, t0, pending = {}, models = {}, modelKey, events, modelCount }
+
+local function nowMs() return os.clock() * 1000 end
+
+--------------------------------------------------------------------------------
+-- Serialization
+--------------------------------------------------------------------------------
+-- Params snapshot: plain data only. Colors become C(r,g,b,a); functions,
+-- other userdata, metrics and private "_" keys are dropped.
+local function snapshot(v, depth)
+  local t = type(v)
+  if t == "number" or t == "string" or t == "boolean" then return v end
+  if t == "userdata" then
+    local ok, c = pcall(function() return { v.red, v.green, v.blue, v.alpha } end)
+    if ok and c[1] then return { _color = c } end
+    return nil
+  end
+  if t ~= "table" or depth > 8 then return nil end
+  local out = {}
+  for k, val in pairs(v) do
+    local tk = type(k)
+    if (tk == "number" or (tk == "string" and k:sub(1, 1) ~= "_" and k ~= "metrics")) then
+      out[k] = snapshot(val, depth + 1)
+    end
+  end
+  return out
+end
+
+local function serialize(v, out)
+  local t = type(v)
+  if t == "table" then
+    if v._color then
+      local c = v._color
+      out[#out + 1] = string.format("C(%d,%d,%d,%d)", c[1], c[2], c[3], c[4] or 255)
+      return
+    end
+    out[#out + 1] = "{"
+    for k, val in pairs(v) do
+      if type(k) == "number" then
+        out[#out + 1] = "[" .. string.format("%.17g", k) .. "]="
+      elseif k:match("^[%a_][%w_]*$") then
+        out[#out + 1] = k .. "="
+      else
+        out[#out + 1] = "[" .. string.format("%q", k) .. "]="
+      end
+      serialize(val, out)
+      out[#out + 1] = ","
+    end
+    out[#out + 1] = "}"
+  elseif t == "number" then
+    out[#out + 1] = (math.type(v) == "integer") and tostring(v) or string.format("%.17g", v)
+  elseif t == "string" then
+    out[#out + 1] = string.format("%q", v)
+  else
+    out[#out + 1] = tostring(v)
+  end
+end
+
+-- Voxels packed as little-endian int16 x,y,z + RGBA bytes
+local function packModel(model)
+  local vb = AseVoxel.render.voxel_buffer
+  local buf = vb.of(model)
+  local X, Y, Z, RGBA = buf.x, buf.y, buf.z, buf.rgba
+  local parts = {}
+  for i = 1, buf.n do
+    parts[i] = string.pack("<i2i2i2BBBB", math.floor(X[i]), math.floor(Y[i]), math.floor(Z[i]),
+      vb.unpack(RGBA[i]))
+  end
+  return table.concat(parts)
+end
+
+local function writeEvent(e)
+  local out = { "E{t=", string.format("%.3f", e.t), ",source=", string.format("%q", e.source),
+                ",model=", string.format("%q", e.model or ""), ",rendered=", tostring(e.rendered),
+                ",params=" }
+  serialize(e.params or {}, out)
+  out[#out + 1] = "}\n"
+  _rec.file:write(table.concat(out))
+  _rec.events = _rec.events + 1
+end
+
+--------------------------------------------------------------------------------
+-- API
+--------------------------------------------------------------------------------
+function sessionRecorder.start(path)
+  sessionRecorder.stop()
+  local f, err = io.open(path, "wb")
+  if not f then return false, err end
+  f:write("-- AseVoxel session (bench/replay.lua)\n")
+  f:write(string.format("V(%d)\n", FORMAT_VERSION))
+  _rec = { file = f, path = path, t0 = nowMs(), pending = {}, models = {}, modelKey = nil,
+           events = 0, modelCount = 0 }
+  return true
+end
+
+function sessionRecorder.isRecording()
+  return _rec ~= nil
+end
+
+-- viewerCore.requestPreview: every request, coalesced or not
+function sessionRecorder.noteRequest(params, source)
+  if not _rec then return end
+  _rec.pending[#_rec.pending + 1] = {
+    t = nowMs() - _rec.t0,
+    source = source or "unknown",
+    params = snapshot(params, 0)
+  }
+end
+
+-- viewerCore.updatePreview: the model about to be rendered
+function sessionRecorder.noteRender(model)
+  if not _rec then return end
+  local key = _rec.modelKey
+  local brickCache = getBrickCache()
+  local grid = model and brickCache and brickCache.update(model)
+  if grid then
+    key = string.format("%.17g:%d", grid.fingerprint, grid.voxelCount)
+    if not _rec.models[key] then
+      _rec.models[key] = true
+      _rec.modelCount = _rec.modelCount + 1
+      _rec.file:write(string.format("M(%q,%d,%q)\n", key, #model, packModel(model)))
+    end
+  end
+  _rec.modelKey = key
+  local pending = _rec.pending
+  for i = 1, #pending do
+    local e = pending[i]
+    e.model = key
+    e.rendered = (i == #pending)
+    writeEvent(e)
+  end
+  _rec.pending = {}
+end
+
+-- Closes the file; returns { path, events, models } or nil when idle
+function sessionRecorder.stop()
+  if not _rec then return nil end
+  for _, e in ipairs(_rec.pending) do
+    e.model = _rec.modelKey
+    e.rendered = false
+    writeEvent(e)
+  end
+  _rec.file:close()
+  local summary = { path = _rec.path, events = _rec.events, models = _rec.modelCount }
+  _rec = nil
+  return summary
+end
+
+function sessionRecorder.getStats()
+  if not _rec then return nil end
+  return { path = _rec.path, events = _rec.events, pending = #_rec.pending, models = _rec.modelCount }
+end
+
+return sessionRecorder
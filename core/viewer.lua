@@ -41,6 +41,10 @@ local function getFxStack()
   return AseVoxel.fxStack
 end
 
+local function getBrickCache()
+  return AseVoxel.render.brick_cache
+end
+
 -- Open the AseVoxel model viewer
 function viewer.open()
   local dialogueManager = getDialogManager()
@@ -282,15 +286,21 @@ function viewer.open()
       z = middlePointLocal.z + cameraDistance
     }
 
-    -- Build depth map from voxels
+    -- Build depth map from shell voxels (interior voxels are never nearest)
     local depthMap = {}
-    for i, v in ipairs(voxelModel) do
-      local t = rotation.transformVoxel(v, {
-        middlePoint = middlePointLocal,
-        xRotation = viewParams.xRotation,
-        yRotation = viewParams.yRotation,
-        zRotation = viewParams.zRotation
-      })
+    local brickCache = getBrickCache()
+    local shell = brickCache and brickCache.getShell(voxelModel)
+      or AseVoxel.render.voxel_buffer.of(voxelModel)
+    local xform = {
+      middlePoint = middlePointLocal,
+      xRotation = viewParams.xRotation,
+      yRotation = viewParams.yRotation,
+      zRotation = viewParams.zRotation
+    }
+    local p = { x = 0, y = 0, z = 0 }
+    for i = 1, shell.n do
+      p.x, p.y, p.z = shell.x[i], shell.y[i], shell.z[i]
+      local t = rotation.transformVoxel(p, xform)
       local sx = math.floor(centerX + (t.x - middlePointLocal.x) * voxelSize + 0.5)
       local sy = math.floor(centerY + (t.y - middlePointLocal.y) * voxelSize + 0.5)
       if sx >= 0 and sx < width and sy >= 0 and sy < height then
@@ -474,6 +484,7 @@ function viewer.open()
         if result then
           previewState.voxelModel = result.model
           previewState.image = result.image
+          previewState.overdrawImage = result.metrics and result.metrics.overdrawImage
           previewState.modelDimensions = result.dimensions
           previewState.resetPan = resetPan
           previewState.viewParams = viewParams
@@ -511,6 +522,24 @@ function viewer.open()
   dialogueManager.mainDialog = mainDlg
   dialogueManager.previewDialog = previewDlg
   
+  -- Timeline scrubbing/playback: re-render when the active frame changes
+  -- (timeline_cache and frame_cache make prefetched frames near-free)
+  if viewer._siteListener then
+    pcall(function() app.events:off(viewer._siteListener) end)
+    viewer._siteListener = nil
+  end
+  local lastFrame = app.activeFrame and app.activeFrame.frameNumber
+  pcall(function()
+    viewer._siteListener = app.events:on("sitechange", function()
+      if dialogueManager.mainDialog ~= mainDlg then return end
+      local frame = app.activeFrame and app.activeFrame.frameNumber
+      if frame and frame ~= lastFrame then
+        lastFrame = frame
+        schedulePreview(false, "timeline")
+      end
+    end)
+  end)
+
   -- Initial preview update
   schedulePreview(true, "immediate")
   
@@ -12,6 +12,18 @@ local function getRotation()
   return AseVoxel.rotation
 end
 
+local function getProfiler()
+  return AseVoxel.utils.performance_profiler
+end
+
+local function getTelemetry()
+  return AseVoxel.utils.telemetry
+end
+
+local function getRecorder()
+  return AseVoxel.core.session_recorder
+end
+
 local viewerCore = {}
 
 viewerCore._sched = {
@@ -27,49 +39,82 @@ viewerCore._sched = {
   sampleIntervalMs = 100,             -- adaptive interval (ms)
 
   -- Adaptive timing
-  renderTimes = {},        -- recent render durations (ms)
-  maxSamples = 50,
+  maxSamples = 50,         -- telemetry window for the throttle's p75
   dynamicEnabled = true,
   dynamicMinMs = 40,       -- lower clamp
   dynamicMaxMs = 440,      -- upper clamp
-  dynamicMultiplier = 3    -- Patch 3.75.2: raise multiplier (Option 2A)
+  dynamicMultiplier = 3,   -- Patch 3.75.2: raise multiplier (Option 2A)
+
+  -- Background native jobs
+  job = nil,               -- in-flight { job, complete, finish, dlg, params, controls, callback }
+  jobPollSec = 0.015,      -- Timer interval while a job is running
+  asyncDisabled = false,   -- set after a worker failure; renders stay inline
+  inlineOnce = false,      -- next frame renders inline (job finished without an image)
+
+  -- Frame-budget quality governor (interactive frames only)
+  governor = {
+    enabled = true,
+    budgetMs = 33,         -- target per interactive frame
+    level = 1,             -- index into QUALITY_LADDER (1 = full quality)
+    stageMs = nil,         -- last per-stage costs, normalized to full quality
+    degraded = false,      -- last frame shown below full quality
+    settlePending = false  -- full-quality frame owed after mouse release
+  },
+  last = nil,              -- { dlg, params, controls, callback } of the last render
+
+  -- Progressive refinement after a drag
+  refine = nil,            -- { level } next QUALITY_LADDER rung to render
+  refineTickSec = 0.05,    -- idle Timer interval between refinement passes
+
+  -- Speculative pre-rendering of neighboring rotations
+  specEnabled = true,
+  spec = nil,              -- { model, params, queue } pending orientations
+  specMax = 6,             -- orientations per seed
+  specStep = 1,            -- degrees for axes without a recent step
+  specTickSec = 0.03,
+  specMaxMs = 30,          -- Lua-path frame cost above which nothing is prefetched
+  specRendered = 0,
+  lastRotation = nil,      -- rotation of the last full-quality frame
+  lastRenderMs = nil,      -- t_total_ms of the last frame not served from cache
+  lastBackend = nil,       -- its metrics.backend
+
+  -- Background voxelize + render of the sprite's other timeline frames
+  timelineEnabled = true,
+  timeline = nil,          -- { sprite, params, queue } pending frame numbers
+  timelineMax = 32,        -- frames per seed (nearest first, wrapping)
+  timelineTickSec = 0.03,
+  timelineMaxMs = 30,      -- tick cost (voxelize + render) that ends a prefetch
+  timelineQuietTicks = 8,  -- idle ticks after a seed before the first prefetch
+  timelineView = nil,      -- { sprite, key, models, done } frames prefetched for a view
+  timelinePrefetched = 0
 }
 
 -- Last render metrics snapshot
 viewerCore._lastMetrics = nil
 
--- Helper: insert render duration & update adaptive interval
+-- Helper: insert render duration & update adaptive interval.
+-- Durations go into the always-on "frame" telemetry histogram (windowed over
+-- maxSamples), whose p75 drives the interval: O(1) per frame, no sorting.
 local function _recordRenderTime(ms)
   local s = viewerCore._sched
   if not s.dynamicEnabled or ms <= 0 then return end
-  local rt = s.renderTimes
-  rt[#rt+1] = ms
-  if #rt > s.maxSamples then
-    table.remove(rt, 1)
-  end
+  local telemetry = getTelemetry()
+  if not telemetry then return end
+  telemetry.metric("frame", s.maxSamples).window = s.maxSamples
+  telemetry.record("frame", ms)
   -- Patch 3.75.2: use 75th percentile instead of median (Option 2B)
-  local tmp = {}
-  for i,v in ipairs(rt) do tmp[i] = v end
-  table.sort(tmp)
-  local n = #tmp
-  local qIndexFloat = 0.75 * (n - 1) + 1     -- linear index (1-based)
-  local qLow = math.floor(qIndexFloat)
-  local qHigh = math.min(n, qLow + 1)
-  local frac = qIndexFloat - qLow
-  local qVal
-  if n == 0 then
-    qVal = ms
-  elseif qLow == qHigh then
-    qVal = tmp[qLow]
-  else
-    qVal = tmp[qLow] + (tmp[qHigh] - tmp[qLow]) * frac
-  end
+  local qVal = telemetry.percentile("frame", 0.75) or ms
   local desired = qVal * s.dynamicMultiplier
   if desired < s.dynamicMinMs then desired = s.dynamicMinMs end
   if desired > s.dynamicMaxMs then desired = s.dynamicMaxMs end
   s.sampleIntervalMs = math.floor(desired + 0.5)
 end
 
+-- Public entry for render paths outside updatePreview (DirectCanvas)
+function viewerCore.recordRenderTime(ms)
+  _recordRenderTime(ms)
+end
+
 function viewerCore.setAdaptiveThrottle(opts)
   local s = viewerCore._sched
   if opts.enabled ~= nil then s.dynamicEnabled = opts.enabled end
@@ -80,30 +125,266 @@ end
 
 function viewerCore.getAdaptiveStats()
   local s = viewerCore._sched
-  local count = #s.renderTimes
+  local telemetry = getTelemetry()
+  local count = telemetry and telemetry.count("frame") or 0
   if count == 0 then return {count=0, median=nil, p75=nil, interval=s.sampleIntervalMs} end
-  local tmp = {}
-  for i,v in ipairs(s.renderTimes) do tmp[i]=v end
-  table.sort(tmp)
-  local n = #tmp
-  local median = (n % 2 == 1) and tmp[(n+1)/2] or (tmp[n/2] + tmp[n/2+1]) / 2
-  local qIndexFloat = 0.75 * (n - 1) + 1
-  local qLow = math.floor(qIndexFloat)
-  local qHigh = math.min(n, qLow + 1)
-  local frac = qIndexFloat - qLow
-  local qVal
-  if qLow == qHigh then qVal = tmp[qLow]
-  else qVal = tmp[qLow] + (tmp[qHigh] - tmp[qLow]) * frac end
-  return {count=count, median=median, p75=qVal, interval=s.sampleIntervalMs}
+  return {
+    count = count,
+    median = telemetry.percentile("frame", 0.5),
+    p75 = telemetry.percentile("frame", 0.75),
+    p95 = telemetry.percentile("frame", 0.95),
+    interval = s.sampleIntervalMs
+  }
 end
 
 local function nowMs() return os.clock() * 1000 end
 
+--------------------------------------------------------------------------------
+-- Quality governor
+-- The throttle above only decides how often to render. The governor decides
+-- how much each interactive frame costs: from the last frame's per-stage
+-- timings it estimates every rung of the ladder and picks the best one that
+-- fits budgetMs. Mouse release renders the final frame at full quality.
+--------------------------------------------------------------------------------
+-- Ordered cheapest-to-lose first. resolution = integer downscale of the
+-- output (upscaled back), lod = brick LOD level, shading = tier cap.
+local QUALITY_LADDER = {
+  { name = "full" },
+  { name = "no-outline", outline = false },
+  { name = "no-ss", outline = false, maxSupersample = 1 },
+  { name = "half-res", outline = false, maxSupersample = 1, resolution = 2 },
+  { name = "lod1", outline = false, maxSupersample = 1, resolution = 2, lod = 1 },
+  { name = "lod1-basic", outline = false, maxSupersample = 1, resolution = 2, lod = 1, shading = "Basic" },
+  { name = "lod2-basic", outline = false, maxSupersample = 1, resolution = 2, lod = 2, shading = "Basic" }
+}
+viewerCore.QUALITY_LADDER = QUALITY_LADDER
+
+-- Relative cost of a rung vs full quality, per stage kind:
+-- vox (per surface voxel), pix (per rendered pixel), shade, outline (0/1)
+local function _qualityFactors(q, params)
+  local scale = params.scaleLevel or 1
+  local function supersample(s, cap)
+    local ss = (s < 1) and math.ceil(1 / s) or 1
+    if cap then ss = math.max(1, math.min(ss, cap)) end
+    return ss
+  end
+  local res = q.resolution or 1
+  local lodScale = 1 << (q.lod or 0)
+  local ssFull = supersample(scale)
+  local ssQ = supersample(scale * lodScale / res, q.maxSupersample)
+  local pixel = (ssQ / ssFull) ^ 2 / (res * res)
+  return {
+    vox = 1 / (lodScale * lodScale),
+    pix = pixel,
+    shade = (q.shading and (params.shadingMode or "Stack") ~= q.shading) and 0.7 or 1,
+    outline = (q.outline == false) and 0 or 1,
+    ss = (ssQ > 1) and 1 or 0
+  }
+end
+
+local function _estimateMs(stage, f)
+  return stage.sort * f.vox
+    + stage.draw * (0.5 * f.vox + 0.5 * f.pix) * f.shade
+    + stage.outline * f.outline * f.pix
+    + stage.downsample * f.ss * f.pix
+    + stage.other * (f.vox + f.pix) * 0.5
+end
+
+-- Fold a governed frame's metrics into the model and choose the next rung
+local function _governorObserve(metrics, q, params)
+  local g = viewerCore._sched.governor
+  if not metrics then return end
+  local f = _qualityFactors(q, params)
+  local sort = metrics.t_transformSort_ms or 0
+  local draw = metrics.t_draw_ms or 0
+  local outline = metrics.t_outline_ms or 0
+  local down = metrics.t_downsample_ms or 0
+  local total = metrics.t_total_ms or metrics.renderTime or 0
+  local other = math.max(0, total - sort - draw - outline - down)
+  local function norm(ms, factor) return (factor > 0) and ms / factor or ms end
+  g.stageMs = {
+    sort = norm(sort, f.vox),
+    draw = norm(draw, (0.5 * f.vox + 0.5 * f.pix) * f.shade),
+    outline = outline > 0 and norm(outline, f.pix) or (g.stageMs and g.stageMs.outline or 0),
+    downsample = down > 0 and norm(down, f.pix) or (g.stageMs and g.stageMs.downsample or 0),
+    other = norm(other, (f.vox + f.pix) * 0.5)
+  }
+  local pick = #QUALITY_LADDER
+  for k = 1, #QUALITY_LADDER do
+    if _estimateMs(g.stageMs, _qualityFactors(QUALITY_LADDER[k], params)) <= g.budgetMs then
+      pick = k
+      break
+    end
+  end
+  if pick < g.level then
+    -- Climb one rung at a time, and only with headroom (avoids oscillation)
+    local up = QUALITY_LADDER[g.level - 1]
+    if _estimateMs(g.stageMs, _qualityFactors(up, params)) <= g.budgetMs * 0.8 then
+      g.level = g.level - 1
+    end
+  else
+    g.level = pick
+  end
+end
+
+local function _governorQuality()
+  local g = viewerCore._sched.governor
+  if not g.enabled then return nil end
+  return QUALITY_LADDER[g.level] or QUALITY_LADDER[1]
+end
+
+function viewerCore.setQualityGovernor(opts)
+  local g = viewerCore._sched.governor
+  if opts.enabled ~= nil then g.enabled = opts.enabled end
+  if opts.budgetMs then g.budgetMs = opts.budgetMs end
+  if opts.level then g.level = math.max(1, math.min(#QUALITY_LADDER, opts.level)) end
+end
+
+function viewerCore.getGovernorStats()
+  local g = viewerCore._sched.governor
+  local q = QUALITY_LADDER[g.level] or QUALITY_LADDER[1]
+  return { enabled = g.enabled, budgetMs = g.budgetMs, level = g.level, quality = q.name, degraded = g.degraded }
+end
+
+--------------------------------------------------------------------------------
+-- Background native jobs
+-- When the native module can render on a worker thread, updatePreview submits
+-- the frame and returns; a Timer polls the job and integrates the image. A
+-- newer request cancels the in-flight job instead of queueing behind it.
+--------------------------------------------------------------------------------
+local _jobTimer = nil
+
+local function _stopJobTimer()
+  if _jobTimer then pcall(function() _jobTimer:stop() end) end
+end
+
+local function _pollJob()
+  local s = viewerCore._sched
+  local rec = s.job
+  if not rec then
+    _stopJobTimer()
+    return
+  end
+  local state = rec.job:poll()
+  if state == "running" then return end
+  s.job = nil
+  _stopJobTimer()
+  local image = (state == "done") and rec.job:result() or nil
+  if image then
+    local ok, res = pcall(rec.complete, image)
+    if not ok then print("viewerCore job completion error: " .. tostring(res)) end
+    rec.finish(ok and res or nil, ok)
+  elseif state == "cancelled" then
+    -- Cancelled from outside the scheduler: nothing to show for this frame
+    rec.finish(nil, false)
+  else
+    -- A worker failure (including a result that does not decode) keeps
+    -- rendering inline for the rest of the session; an empty result only
+    -- redoes this frame inline
+    if rec.job.decodeFailed or rec.job:poll() == "failed" then
+      s.asyncDisabled = true
+    else
+      s.inlineOnce = true
+    end
+    viewerCore.updatePreview(rec.dlg, rec.params, rec.controls, rec.callback, rec.quality)
+  end
+end
+
+--------------------------------------------------------------------------------
+-- Progressive refinement
+-- After a reduced-quality drag the final frame is not rendered in one go: a
+-- coarse pass (half resolution, no outline, no supersampling) is shown first,
+-- then idle Timer ticks walk back up the ladder to full quality. Any new
+-- request pre-empts the remaining passes.
+--------------------------------------------------------------------------------
+local _refineTimer = nil
+local COARSE_LEVEL = 4  -- QUALITY_LADDER "half-res"
+
+local function _stopRefine()
+  viewerCore._sched.refine = nil
+  if _refineTimer then pcall(function() _refineTimer:stop() end) end
+end
+
+-- Render the next pass; the last one (rung 1) goes through the plain path
+local function _refineStep()
+  local s = viewerCore._sched
+  local r = s.refine
+  if not r or not s.last then
+    _stopRefine()
+    return
+  end
+  local level = r.level
+  if level <= 1 then
+    _stopRefine()
+  else
+    r.level = level - 1
+  end
+  s.renderingInProgress = true
+  viewerCore.updatePreview(s.last.dlg, s.last.params, s.last.controls, s.last.callback,
+    (level > 1) and QUALITY_LADDER[level] or nil)
+end
+
+local function _refineTick()
+  local s = viewerCore._sched
+  -- Busy (render or job in flight, or input queued): wait for an idle tick
+  if s.renderingInProgress or s.pendingParams then return end
+  _refineStep()
+end
+
+-- Start refining from the rung the drag ended on
+local function _startRefine()
+  local s = viewerCore._sched
+  local dragLevel = s.governor.level
+  local start = (dragLevel > COARSE_LEVEL) and COARSE_LEVEL or (dragLevel - 1)
+  if not Timer or start <= 1 then
+    -- No idle timer (or one pass left): single full-quality render
+    s.refine = { level = 1 }
+    _refineStep()
+    return
+  end
+  s.refine = { level = start }
+  _refineStep()
+  if not _refineTimer then
+    _refineTimer = Timer{ interval = s.refineTickSec, ontick = _refineTick }
+  end
+  _refineTimer:start()
+end
+
+local function _startJob(rec)
+  viewerCore._sched.job = rec
+  if not _jobTimer then
+    _jobTimer = Timer{ interval = viewerCore._sched.jobPollSec, ontick = _pollJob }
+  end
+  _jobTimer:start()
+end
+
+-- Abandon the in-flight job (its frame is already stale). Its caller still
+-- hears back, with a nil result as for any frame that produced nothing.
+local function _cancelJob()
+  local s = viewerCore._sched
+  local rec = s.job
+  if not rec then return false end
+  s.job = nil
+  _stopJobTimer()
+  rec.job:cancel()
+  s.renderingInProgress = false
+  if rec.callback then pcall(rec.callback, nil) end
+  return true
+end
+
 local function _onRenderComplete()
   local s = viewerCore._sched
   s.renderingInProgress = false
   local p = s.pendingParams
-  if not p then return end
+  if not p then
+    -- Mouse released on a reduced-quality frame: refine it to full quality
+    local g = s.governor
+    if g.settlePending and s.last then
+      g.settlePending = false
+      _startRefine()
+    end
+    return
+  end
   if s.pendingIsMouse then
     local elapsed = nowMs() - s.lastMouseSampleTime
     if elapsed < s.sampleIntervalMs then return end
@@ -116,6 +397,7 @@ local function _onRenderComplete()
   local dlg = s.pendingDlg
   local controls = s.pendingControls
   local cb = s.pendingCallback
+  local quality = (s.pendingIsMouse or s.pendingIsControls) and _governorQuality() or nil
   s.pendingParams = nil
   s.pendingDlg = nil
   s.pendingControls = nil
@@ -123,7 +405,7 @@ local function _onRenderComplete()
   s.pendingIsControls = false
   s.pendingCallback = nil
   s.renderingInProgress = true
-  viewerCore.updatePreview(dlg, p, controls, cb)
+  viewerCore.updatePreview(dlg, p, controls, cb, quality)
 end
 
 function viewerCore.requestPreview(dlg, params, controlsDialog, source, callback)
@@ -132,6 +414,13 @@ function viewerCore.requestPreview(dlg, params, controlsDialog, source, callback
   local isMouse = (source == "mouseMove")
   local isControls = (source == "controls")
   local t = nowMs()
+  local profiler = getProfiler()
+  if profiler and profiler.isTracing() then profiler.traceInstant("request", "scheduler", source) end
+  local recorder = getRecorder()
+  if recorder and recorder.isRecording() then recorder.noteRequest(params, source) end
+  -- New input pre-empts any refinement still in progress
+  if s.refine then _stopRefine() end
+  if not (isMouse or isControls) then s.governor.settlePending = false end
 
   if isMouse and (t - s.lastMouseSampleTime) < s.sampleIntervalMs then
     s.pendingParams = params
@@ -152,6 +441,11 @@ function viewerCore.requestPreview(dlg, params, controlsDialog, source, callback
     return
   end
 
+  if s.renderingInProgress and s.job then
+    -- Never wait on a stale frame: drop the running job and render this one
+    _cancelJob()
+  end
+
   if s.renderingInProgress then
     s.pendingParams = params
     s.pendingDlg = dlg
@@ -168,20 +462,297 @@ function viewerCore.requestPreview(dlg, params, controlsDialog, source, callback
     s.lastControlSampleTime = t
   end
   s.renderingInProgress = true
-  viewerCore.updatePreview(dlg, params, controlsDialog, callback)
+  viewerCore.updatePreview(dlg, params, controlsDialog, callback,
+    (isMouse or isControls) and _governorQuality() or nil)
 end
 
+-- Mouse release: the last drag frame is refined up to full quality
 function viewerCore.flush()
   local s = viewerCore._sched
+  if s.pendingParams then
+    -- The latest queued input becomes the frame to refine
+    s.last = { dlg = s.pendingDlg, params = s.pendingParams, controls = s.pendingControls, callback = s.pendingCallback }
+    s.pendingParams = nil
+    s.pendingDlg = nil
+    s.pendingControls = nil
+    s.pendingIsMouse = false
+    s.pendingIsControls = false
+    s.pendingCallback = nil
+    s.governor.settlePending = true
+  elseif s.governor.degraded then
+    s.governor.settlePending = true
+  end
   if s.renderingInProgress then return end
   _onRenderComplete()
 end
 
-function viewerCore.updatePreview(dlg, params, controlsDialog, callback)
+-- Viewer params -> renderVoxelModel params (without metrics)
+local function _buildRenderParams(params, dialogueManager)
+  return {
+    x = params.xRotation,
+    y = params.yRotation,
+    z = params.zRotation,
+    -- Keep depthPerspective for backward compatibility if passed, but prefer explicit fovDegrees
+    fovDegrees = params.fovDegrees or params.fov or (params.depthPerspective and (5 + (75-5)*(params.depthPerspective/100))) or 45,
+    orthogonal = params.orthogonalView, -- no automatic orthographic when FOV small
+    perspectiveScaleRef = params.perspectiveScaleRef or "middle",
+    enableOutline = params.enableOutline,
+    outlineColor = params.outlineColor,
+    outlinePattern = params.outlinePattern,
+    scaleLevel = params.scaleLevel,
+    rotationMatrix = params.rotationMatrix 
+      or (dialogueManager and dialogueManager.currentRotationMatrix),
+    fxStack = params.fxStack,
+    -- Forward mesh-mode toggle so previewRenderer / native can choose mesh pipeline
+    mesh = params.mesh or params.meshMode,
+    meshMode = params.meshMode or params.mesh,
+    shadingMode = params.shadingMode or "Stack",
+    lighting = params.lighting and {
+      pitch = params.lighting.pitch or 25,
+      yaw = params.lighting.yaw or 25,
+      diffuse = params.lighting.diffuse or 60,
+      diameter = params.lighting.diameter or 100,
+      ambient = params.lighting.ambient or 30,
+      lightColor = params.lighting.lightColor or Color(255,255,255),
+      rimEnabled = (params.lighting.rimEnabled ~= false),
+      previewRotateEnabled = params.lighting.previewRotateEnabled or false
+    } or nil,
+    basicShadeIntensity = params.basicShadeIntensity,
+    basicLightIntensity = params.basicLightIntensity,
+    enableProfiling = params.enableProfiling,
+    overdraw = params.overdrawOverlay,
+    -- Preview frames may come from the cache at a nearby (quantized) angle
+    cacheQuantized = true
+  }
+end
+
+-- Same mapping for headless tools (bench/replay.lua)
+viewerCore.buildRenderParams = _buildRenderParams
+
+--------------------------------------------------------------------------------
+-- Speculative pre-rendering
+-- After a full-quality frame, idle ticks render the likely next orientations
+-- into the frame cache: the last rotation step continued, then reversed, then
+-- +/-specStep on the axes that did not move. Stepping a slider or arrow onto
+-- one of them is then a cache lookup instead of a render.
+--------------------------------------------------------------------------------
+local _specTimer = nil
+
+local function _stopSpec()
+  viewerCore._sched.spec = nil
+  if _specTimer then pcall(function() _specTimer:stop() end) end
+end
+
+-- Prefetch renders run synchronously on the UI thread: input arriving during
+-- one waits for it to finish. Native frames are cheap enough; Lua frames only
+-- when the last measured one fit budgetMs.
+local function _prefetchAffordable(budgetMs)
+  local s = viewerCore._sched
+  if s.lastBackend and s.lastBackend:find("^native") then return true end
+  return s.lastRenderMs ~= nil and s.lastRenderMs <= budgetMs
+end
+
+local function _specTick()
+  local s = viewerCore._sched
+  local sp = s.spec
+  if not sp or #sp.queue == 0 or not _prefetchAffordable(s.specMaxMs) then
+    _stopSpec()
+    return
+  end
+  -- Only truly idle ticks: real frames, refinement and input come first
+  if s.renderingInProgress or s.pendingParams or s.refine or s.job then return end
+  local rot = table.remove(sp.queue, 1)
+  local p = {}
+  for k, v in pairs(sp.params) do p[k] = v end
+  p.xRotation, p.yRotation, p.zRotation = rot[1], rot[2], rot[3]
+  local renderParams = _buildRenderParams(p, package.loaded["dialogueManager"])
+  renderParams.metrics = {}
+  -- renderVoxelModel stores the frame in the frame cache
+  local previewRenderer = getPreviewRenderer()
+  local key = previewRenderer.frameKey(sp.model, renderParams)
+  if key and not AseVoxel.render.frame_cache.peek(key) then
+    local ok, img = pcall(previewRenderer.renderVoxelModel, sp.model, renderParams)
+    if ok and img then
+      s.specRendered = s.specRendered + 1
+    end
+    -- Over budget on the Lua path: the rest of the queue would stall as long
+    local m = renderParams.metrics
+    if not (m.backend and m.backend:find("^native")) and (m.t_total_ms or 0) > s.specMaxMs then
+      _stopSpec()
+    end
+  end
+end
+
+local function _seedSpeculation(model, params)
+  local s = viewerCore._sched
+  if not (s.specEnabled and Timer and model and params) then return end
+  local cur = { params.xRotation or 0, params.yRotation or 0, params.zRotation or 0 }
+  local prev = s.lastRotation
+  s.lastRotation = cur
+  if not _prefetchAffordable(s.specMaxMs) then
+    _stopSpec()
+    return
+  end
+  local queue = {}
+  local function add(axis, d)
+    if #queue >= s.specMax then return end
+    local c = { cur[1], cur[2], cur[3] }
+    c[axis] = (c[axis] + d) % 360
+    queue[#queue + 1] = c
+  end
+  local moved = {}
+  for axis = 1, 3 do
+    local d = prev and ((cur[axis] - prev[axis] + 180) % 360 - 180) or 0
+    if d ~= 0 and math.abs(d) <= 45 then
+      moved[axis] = true
+      add(axis, d)
+      add(axis, -d)
+    end
+  end
+  for axis = 1, 3 do
+    if not moved[axis] then
+      add(axis, s.specStep)
+      add(axis, -s.specStep)
+    end
+  end
+  s.spec = { model = model, params = params, queue = queue }
+  if not _specTimer then
+    _specTimer = Timer{ interval = s.specTickSec, ontick = _specTick }
+  end
+  _specTimer:start()
+end
+
+function viewerCore.getSpeculationStats()
+  local s = viewerCore._sched
+  return { queued = s.spec and #s.spec.queue or 0, rendered = s.specRendered }
+end
+
+--------------------------------------------------------------------------------
+-- Timeline prefetch
+-- After a full-quality frame, idle ticks voxelize the sprite's other frames
+-- (nearest first, wrapping like playback) through timeline_cache and render
+-- them at the current camera into the frame cache. Scrubbing or playing the
+-- timeline then finds model and image ready. Speculative rotations go first.
+--------------------------------------------------------------------------------
+local _timelineTimer = nil
+
+local function _stopTimeline()
+  viewerCore._sched.timeline = nil
+  if _timelineTimer then pcall(function() _timelineTimer:stop() end) end
+end
+
+local function _timelineTick()
+  local s = viewerCore._sched
+  local tl = s.timeline
+  if not tl or #tl.queue == 0 or app.activeSprite ~= tl.sprite then
+    _stopTimeline()
+    return
+  end
+  if s.renderingInProgress or s.pendingParams or s.refine or s.job or s.spec then return end
+  -- Wait out slider steps and scrubbing, which re-seed every frame
+  if tl.wait > 0 then
+    tl.wait = tl.wait - 1
+    return
+  end
+  local frame = table.remove(tl.queue, 1)
+  local t0 = nowMs()
+  local ok = pcall(function()
+    local model = AseVoxel.render.timeline_cache.getModel(tl.sprite, frame)
+    if #model == 0 then return end
+    local renderParams = _buildRenderParams(tl.params, package.loaded["dialogueManager"])
+    renderParams.metrics = {}
+    getPreviewRenderer().renderVoxelModel(model, renderParams)
+  end)
+  if ok then
+    s.timelinePrefetched = s.timelinePrefetched + 1
+    tl.view.done[frame] = true
+  end
+  -- Each tick blocks the UI thread; stop once one costs more than the budget
+  if nowMs() - t0 > s.timelineMaxMs then _stopTimeline() end
+end
+
+-- model: the current frame's model, to notice edits to the sprite
+local function _seedTimeline(params, model)
+  local s = viewerCore._sched
+  local timelineCache = AseVoxel.render.timeline_cache
+  if not (s.timelineEnabled and Timer and timelineCache and timelineCache.enabled) then return end
+  local sprite = app.activeSprite
+  if not sprite or #sprite.frames < 2 then return end
+  local scroll = getPreviewRenderer().layerScrollMode
+  if scroll and scroll.enabled then return end
+  if not _prefetchAffordable(s.timelineMaxMs) then
+    _stopTimeline()
+    return
+  end
+  local n = #sprite.frames
+  local cur = (app.activeFrame and app.activeFrame.frameNumber) or 1
+  -- Frames already prefetched for this sprite and view are not queued again.
+  -- The view key is the frame cache's params serialization (rotation included);
+  -- a new model for a frame seen before means the sprite was edited.
+  local key = AseVoxel.render.frame_cache.makeKey("", 0,
+    _buildRenderParams(params, package.loaded["dialogueManager"]))
+  local view = s.timelineView
+  if not view or view.sprite ~= sprite or view.key ~= key
+     or (view.models[cur] and view.models[cur] ~= model) then
+    view = { sprite = sprite, key = key, models = {}, done = {} }
+    s.timelineView = view
+  end
+  view.models[cur] = model
+  view.done[cur] = true
+  local queue, seen, window = {}, { [cur] = true }, 0
+  local function add(f)
+    if window < s.timelineMax and not seen[f] then
+      seen[f] = true
+      window = window + 1
+      if not view.done[f] then queue[#queue + 1] = f end
+    end
+  end
+  for d = 1, n - 1 do
+    add((cur - 1 + d) % n + 1)   -- playback direction first
+    add((cur - 1 - d) % n + 1)
+  end
+  if #queue == 0 then
+    _stopTimeline()
+    return
+  end
+  s.timeline = { sprite = sprite, params = params, queue = queue, view = view,
+                 wait = s.timelineQuietTicks }
+  if not _timelineTimer then
+    _timelineTimer = Timer{ interval = s.timelineTickSec, ontick = _timelineTick }
+  end
+  _timelineTimer:start()
+end
+
+function viewerCore.getTimelineStats()
+  local s = viewerCore._sched
+  local timelineCache = AseVoxel.render.timeline_cache
+  local st = timelineCache and timelineCache.getStats() or {}
+  st.queued = s.timeline and #s.timeline.queue or 0
+  st.prefetched = s.timelinePrefetched
+  return st
+end
+
+-- quality: optional QUALITY_LADDER rung chosen by the governor (nil = full)
+function viewerCore.updatePreview(dlg, params, controlsDialog, callback, quality)
   local startTime = nowMs()
+  local s = viewerCore._sched
+  s.last = { dlg = dlg, params = params, controls = controlsDialog, callback = callback }
   local function finish(result, counted)
     if counted then
       _recordRenderTime(nowMs() - startTime)
+      local profiler = getProfiler()
+      if profiler and profiler.isTracing() then
+        profiler.traceSpan("frame", startTime, nowMs() - startTime, "scheduler",
+          quality and quality.name or "full")
+      end
+      if quality then
+        _governorObserve(result and result.metrics, quality, params)
+      end
+      s.governor.degraded = (quality ~= nil and quality ~= QUALITY_LADDER[1])
+      if result and not s.governor.degraded then
+        _seedSpeculation(result.model, params)
+        _seedTimeline(params, result.model)
+      end
     end
     if callback then pcall(function() callback(result) end) end
     _onRenderComplete()
@@ -202,82 +773,122 @@ function viewerCore.updatePreview(dlg, params, controlsDialog, callback)
     local previewRenderer = getPreviewRenderer()
     local voxelModel = previewRenderer.generateVoxelModel(sprite)
     if #voxelModel == 0 then return nil end
+    local recorder = getRecorder()
+    if recorder and recorder.isRecording() then recorder.noteRender(voxelModel) end
     local middlePoint = previewRenderer.calculateMiddlePoint(voxelModel)
+    local q = quality or QUALITY_LADDER[1]
+
+    local renderParams = _buildRenderParams(params, dialogueManager)
+    renderParams.metrics = {
+      startTime = startTime,
+      params = params,
+      controlsDialog = controlsDialog
+    }
 
-    local renderParams = {
-      x = params.xRotation,
-      y = params.yRotation,
-      z = params.zRotation,
-      -- Keep depthPerspective for backward compatibility if passed, but prefer explicit fovDegrees
-      fovDegrees = params.fovDegrees or params.fov or (params.depthPerspective and (5 + (75-5)*(params.depthPerspective/100))) or 45,
-      orthogonal = params.orthogonalView, -- no automatic orthographic when FOV small
-      perspectiveScaleRef = params.perspectiveScaleRef or "middle",
-      enableOutline = params.enableOutline,
-      outlineColor = params.outlineColor,
-      outlinePattern = params.outlinePattern,
-      scaleLevel = params.scaleLevel,
-      rotationMatrix = params.rotationMatrix 
-        or (dialogueManager and dialogueManager.currentRotationMatrix),
-      fxStack = params.fxStack,
-      -- Forward mesh-mode toggle so previewRenderer / native can choose mesh pipeline
-      mesh = params.mesh or params.meshMode,
-      meshMode = params.meshMode or params.mesh,
-      shadingMode = params.shadingMode or "Stack",
-      lighting = params.lighting and {
-        pitch = params.lighting.pitch or 25,
-        yaw = params.lighting.yaw or 25,
-        diffuse = params.lighting.diffuse or 60,
-        diameter = params.lighting.diameter or 100,
-        ambient = params.lighting.ambient or 30,
-        lightColor = params.lighting.lightColor or Color(255,255,255),
-        rimEnabled = (params.lighting.rimEnabled ~= false),
-        previewRotateEnabled = params.lighting.previewRotateEnabled or false
-      } or nil,
-      basicShadeIntensity = params.basicShadeIntensity,
-      basicLightIntensity = params.basicLightIntensity,
-      metrics = {
-        startTime = startTime,
-        params = params,
-        controlsDialog = controlsDialog
+    -- Apply the governor's rung (geometry stays in full-model coordinates for
+    -- the caller: only the rendered stand-in and its scale change)
+    local renderModel = voxelModel
+    local resolution = q.resolution or 1
+    if q.lod then
+      local brickCache = AseVoxel.render.brick_cache
+      if brickCache then
+        renderModel = brickCache.getLod(voxelModel, q.lod)
+        renderParams.scaleLevel = (renderParams.scaleLevel or 1) * (1 << q.lod)
+      end
+    end
+    if resolution > 1 then
+      renderParams.width = math.floor((params.width or 200) / resolution)
+      renderParams.height = math.floor((params.height or 200) / resolution)
+      renderParams.scaleLevel = (renderParams.scaleLevel or 1) / resolution
+    end
+    if q.outline == false then renderParams.enableOutline = false end
+    renderParams.maxSupersample = q.maxSupersample
+    if q.shading and renderParams.shadingMode ~= "Basic" then
+      renderParams.shadingMode = q.shading
+    end
+    renderParams.metrics.quality = q.name
+
+    -- Everything after the render itself (shared by the inline and job paths)
+    local function completeRender(previewImage)
+      if previewImage and resolution > 1 then
+        previewImage = previewRenderer.upscaleInteger(previewImage, resolution)
+        local heat = renderParams.metrics.overdrawImage
+        if heat then renderParams.metrics.overdrawImage = previewRenderer.upscaleInteger(heat, resolution) end
+      end
+      pcall(function() dlg:repaint() end)
+
+      -- Optional control dialog UI sync
+      if controlsDialog and dialogueManager 
+         and (not dialogueManager.isUpdatingControls and not dialogueManager.updateLock) then
+        pcall(function()
+          dialogueManager.isUpdatingControls = true
+          controlsDialog:modify{
+            id="scaleLabel",
+            text="Scale: " .. string.format("%.0f%%", params.scaleLevel * 100)
+          }
+          dialogueManager.isUpdatingControls = false
+        end)
+      end
+
+      -- NEW: snapshot metrics after render
+      -- The renderer populates/updates renderParams.metrics. Use that same table as the canonical snapshot.
+      local metrics = renderParams.metrics or {}
+      -- Ensure a total render time is available (fallback to wall time)
+      metrics.renderTime = metrics.renderTime or (nowMs() - startTime)
+      metrics.t_total_ms = metrics.t_total_ms or metrics.renderTime
+      viewerCore._lastMetrics = metrics
+      if metrics.backend ~= "frame-cache" then
+        s.lastRenderMs, s.lastBackend = metrics.t_total_ms, metrics.backend
+      end
+      local telemetry = getTelemetry()
+      if telemetry and metrics.backend ~= "frame-cache" then
+        telemetry.recordStages(metrics)
+        if metrics.luaAllocKB then telemetry.record("alloc.frame_kb", metrics.luaAllocKB) end
+        if metrics.drawAllocKB then telemetry.record("alloc.draw_kb", metrics.drawAllocKB) end
+      end
+
+      return {
+        image = previewImage,
+        model = voxelModel,
+        dimensions = middlePoint,
+        -- NEW: include metrics in return
+        metrics = metrics
       }
-     }
-
-    local previewImage = previewRenderer.renderVoxelModel(voxelModel, renderParams)
-    pcall(function() dlg:repaint() end)
-
-    -- Optional control dialog UI sync
-    if controlsDialog and dialogueManager 
-       and (not dialogueManager.isUpdatingControls and not dialogueManager.updateLock) then
-      pcall(function()
-        dialogueManager.isUpdatingControls = true
-        controlsDialog:modify{
-          id="scaleLabel",
-          text="Scale: " .. string.format("%.0f%%", params.scaleLevel * 100)
-        }
-        dialogueManager.isUpdatingControls = false
-      end)
     end
 
-    -- NEW: snapshot metrics after render
-    -- The renderer populates/updates renderParams.metrics. Use that same table as the canonical snapshot.
-    local metrics = renderParams.metrics or {}
-    -- Ensure a total render time is available (fallback to wall time)
-    metrics.renderTime = metrics.renderTime or (nowMs() - startTime)
-    metrics.t_total_ms = metrics.t_total_ms or metrics.renderTime
-    viewerCore._lastMetrics = metrics
-
-    return {
-      image = previewImage,
-      model = voxelModel,
-      dimensions = middlePoint,
-      -- NEW: include metrics in return
-      metrics = metrics
-    }
+    local inline = s.inlineOnce
+    s.inlineOnce = false
+    if Timer and not s.asyncDisabled and not inline then
+      local job = previewRenderer.submitVoxelModel(renderModel, renderParams)
+      if job then
+        return { pending = job, complete = completeRender }
+      end
+    end
+    -- Lua heap growth across a blocking render; a collection during the
+    -- frame hides its garbage, so only clean (non-negative) deltas count
+    local kb0 = collectgarbage("count")
+    local image = previewRenderer.renderVoxelModel(renderModel, renderParams)
+    local kb = collectgarbage("count") - kb0
+    if kb >= 0 then renderParams.metrics.luaAllocKB = kb end
+    return completeRender(image)
   end)
   if not ok then
     print("viewerCore.updatePreview error: " .. tostring(resultOrErr))
     return finish(nil, false)
   end
+  if resultOrErr and resultOrErr.pending then
+    _startJob({
+      job = resultOrErr.pending,
+      complete = resultOrErr.complete,
+      finish = finish,
+      dlg = dlg,
+      params = params,
+      controls = controlsDialog,
+      callback = callback,
+      quality = quality
+    })
+    return nil
+  end
   return finish(resultOrErr, true)
 end
 
@@ -285,15 +896,14 @@ function viewerCore.calculateContrastColor(voxelModel)
   if not voxelModel or #voxelModel == 0 then
     return Color(128,128,128)
   end
-  local totalR,totalG,totalB,count = 0,0,0,0
-  for _,v in ipairs(voxelModel) do
-    local c = v.color
-    if c then
-      totalR = totalR + (c.r or 0)
-      totalG = totalG + (c.g or 0)
-      totalB = totalB + (c.b or 0)
-      count = count + 1
-    end
+  local buf = AseVoxel.render.voxel_buffer.of(voxelModel)
+  local rgba = buf.rgba
+  local totalR,totalG,totalB,count = 0,0,0,buf.n
+  for i = 1, count do
+    local c = rgba[i]
+    totalR = totalR + ((c >> 24) & 255)
+    totalG = totalG + ((c >> 16) & 255)
+    totalB = totalB + ((c >> 8) & 255)
   end
   if count == 0 then return Color(128,128,128) end
   local avgR,avgG,avgB = totalR/count,totalG/count,totalB/count
@@ -175,10 +175,41 @@ function viewerState.applyRenderResult(result, mainDlg, previewDlg, state)
             interval or 0,
             p75 and (tostring(p75).." ms") or "n/a")
         }
+        local gov = viewerCore and viewerCore.getGovernorStats and viewerCore.getGovernorStats()
+        if gov then
+          mainDlg:modify{
+            id = "perf_quality",
+            text = string.format("Drag quality: %s (budget %d ms)%s",
+              gov.enabled and gov.quality or "off", gov.budgetMs, m.quality and m.quality ~= "full" and " [reduced]" or "")
+          }
+        end
         mainDlg:modify{
           id = "perf_counts",
-          text = string.format("Voxels=%d Faces: drawn=%d, backface=%d, adj-cull=%d",
-            m.voxels or 0, m.facesDrawn or 0, m.facesBackfaced or 0, m.facesCulledAdj or 0)
+          text = m.pixelsWritten
+            and string.format("Voxels=%d Faces drawn=%d Pixels=%d Overdraw=%.2fx%s",
+              m.voxels or 0, m.facesDrawn or 0, m.pixelsWritten, m.overdraw or 0,
+              m.wastedWrites and string.format(" Wasted=%d", m.wastedWrites) or "")
+            or string.format("Voxels=%d Faces: drawn=%d, backface=%d, adj-cull=%d%s",
+              m.voxels or 0, m.facesDrawn or 0, m.facesBackfaced or 0, m.facesCulledAdj or 0,
+              m.drawAllocKB and string.format(" Alloc=%.1fKB", m.drawAllocKB) or "")
+        }
+        -- uncached: frames rebuilt on every request (cels without Image.bytes or id)
+        local tl = viewerCore and viewerCore.getTimelineStats and viewerCore.getTimelineStats()
+        if tl then
+          mainDlg:modify{
+            id = "perf_timeline",
+            text = string.format("Timeline cache: %d frames, %d hits, %d builds, %d uncached, %d prefetched",
+              tl.frames or 0, tl.hits or 0, tl.builds or 0, tl.uncached or 0, tl.prefetched or 0)
+          }
+        end
+        local od = m.overdrawStats
+        mainDlg:modify{
+          id = "overdrawStats",
+          text = od and string.format(
+            "Overdraw: depth %.2f (max %d), wasted %d of %d writes, %.1f px/face, single-write %.0f%%",
+            od.depthComplexity, od.maxDepth, od.wastedWrites, od.pixelsWritten, od.pixelsPerFace,
+            od.pixelsCovered > 0 and 100 * od.histogram[1] / od.pixelsCovered or 0)
+            or "Overdraw: off"
         }
       end)
     end
@@ -131,6 +131,29 @@ function animationDialog.open(viewParams, voxelModel, modelDimensions)
     text = string.format("Current scale: %.0f%%", viewParams.scaleLevel * 100)
   }
   
+  dlg:separator()
+
+  -- Output: sprite frames, or streamed to disk (no frame limit, flat memory)
+  local OUTPUT_FORMATS = { ["PNG sequence"] = "png", ["APNG"] = "apng", ["GIF"] = "gif" }
+  dlg:combobox{
+    id = "output",
+    label = "Output:",
+    options = { "Sprite frames", "PNG sequence", "APNG", "GIF" },
+    option = "Sprite frames",
+    onchange = function()
+      local fmt = OUTPUT_FORMATS[dlg.data.output]
+      dlg:modify{ id = "exportPath", visible = fmt ~= nil }
+    end
+  }
+  dlg:file{
+    id = "exportPath",
+    label = "File:",
+    save = true,
+    filename = "turntable.png",
+    filetypes = { "png", "gif" },
+    visible = false
+  }
+
   dlg:separator()
   
   dlg:button{
@@ -164,11 +187,31 @@ function animationDialog.open(viewParams, voxelModel, modelDimensions)
         perspectiveScaleRef = viewParams.perspectiveScaleRef
       }
       
-      previewUtils.createAnimation(voxelModel, modelDimensions, params)
+      local fmt = OUTPUT_FORMATS[dlg.data.output]
+      if fmt then
+        if not dlg.data.exportPath or dlg.data.exportPath == "" then
+          app.alert("Choose an output file first!")
+          return
+        end
+        params.exportFormat = fmt
+        params.exportPath = dlg.data.exportPath
+        previewUtils.exportAnimation(voxelModel, modelDimensions, params)
+      else
+        previewUtils.createAnimation(voxelModel, modelDimensions, params)
+      end
       dlg:close()
     end
   }
   
+  dlg:button{
+    id = "sheetButton",
+    text = "Sprite Sheet...",
+    onclick = function()
+      dlg:close()
+      animationDialog.openSpriteSheet(viewParams, voxelModel, modelDimensions)
+    end
+  }
+
   dlg:button{
     id = "cancelButton",
     text = "Cancel",
@@ -180,4 +223,90 @@ function animationDialog.open(viewParams, voxelModel, modelDimensions)
   dlg:show{ wait = true }
 end
 
+-- Directional sprite-sheet baker (directions x elevations, one sheet + JSON)
+function animationDialog.openSpriteSheet(viewParams, voxelModel, modelDimensions)
+  if not voxelModel or #voxelModel == 0 then
+    app.alert("No model to bake!")
+    return
+  end
+
+  local dlg = Dialog("Bake Sprite Sheet")
+  dlg:combobox{
+    id = "directions",
+    label = "Directions:",
+    options = { "4", "8", "16", "32" },
+    option = "8"
+  }
+  dlg:entry{
+    id = "elevations",
+    label = "Elevations:",
+    text = "30"
+  }
+  dlg:combobox{
+    id = "yawAxis",
+    label = "Turn Axis:",
+    options = { "X", "Y", "Z" },
+    option = "Y"
+  }
+  dlg:number{ id = "cellSize", label = "Cell Size:", text = "64", decimals = 0 }
+  dlg:number{ id = "padding", label = "Padding:", text = "1", decimals = 0 }
+  dlg:file{
+    id = "sheetPath",
+    label = "File:",
+    save = true,
+    filename = "sheet.png",
+    filetypes = { "png" }
+  }
+  dlg:separator()
+
+  dlg:button{
+    id = "bakeButton",
+    text = "Bake",
+    focus = true,
+    onclick = function()
+      local elevations = {}
+      for v in tostring(dlg.data.elevations):gmatch("[-%d%.]+") do
+        elevations[#elevations + 1] = tonumber(v)
+      end
+      if #elevations == 0 then elevations = { 0 } end
+      local cell = math.max(8, math.floor(dlg.data.cellSize or 64))
+      local sheet, atlas = AseVoxel.io.export_sprite_sheet.bake(voxelModel, {
+        scaleLevel = viewParams.scaleLevel or 1.0,
+        orthogonal = viewParams.orthogonalView,
+        fovDegrees = viewParams.fovDegrees,
+        perspectiveScaleRef = viewParams.perspectiveScaleRef,
+        shadingMode = viewParams.shadingMode,
+        fxStack = viewParams.fxStack,
+        lighting = viewParams.lighting,
+        enableOutline = viewParams.enableOutline,
+        outlineSettings = viewParams.outlineSettings
+      }, {
+        directions = tonumber(dlg.data.directions) or 8,
+        elevations = elevations,
+        yawAxis = dlg.data.yawAxis,
+        cellWidth = cell,
+        cellHeight = cell,
+        padding = math.max(0, math.floor(dlg.data.padding or 0)),
+        rotationMatrix = getDialogManager().getCurrentRotationMatrix(),
+        path = dlg.data.sheetPath
+      })
+      if sheet then
+        app.alert(string.format("Baked %d views to:\n%s", #atlas.frames, atlas.jsonPath))
+        dlg:close()
+      else
+        app.alert("Sprite sheet bake failed: " .. tostring(atlas))
+      end
+    end
+  }
+  dlg:button{
+    id = "cancelButton",
+    text = "Cancel",
+    onclick = function()
+      dlg:close()
+    end
+  }
+
+  dlg:show{ wait = true }
+end
+
 return animationDialog
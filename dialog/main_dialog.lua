@@ -93,10 +93,20 @@ function mainDialog.create(viewParams, schedulePreview, rotateModel, updateLayer
     text = "Adaptive throttle: n/a"
   }
   mainDlg:newrow()
+  mainDlg:label{
+    id = "perf_quality",
+    text = "Drag quality: n/a"
+  }
+  mainDlg:newrow()
   mainDlg:label{
     id = "perf_counts",
     text = "Voxels=0 Faces: drawn=0, backface=0, adj-cull=0"
   }
+  mainDlg:newrow()
+  mainDlg:label{
+    id = "perf_timeline",
+    text = "Timeline cache: n/a"
+  }
 
   -- Rendering Mode Selection
   mainDlg:separator{ text = "Rendering" }
@@ -504,6 +514,12 @@ function mainDialog.create(viewParams, schedulePreview, rotateModel, updateLayer
   mainDlg:newrow()
   mainDlg:label{ id = "debugExport", text = "Last export: n/a" }
   mainDlg:newrow()
+  mainDlg:label{ id = "debugFrameCache", text = "Frame cache: n/a" }
+  mainDlg:newrow()
+  mainDlg:label{ id = "debugTelemetry", text = "Frames: n/a" }
+  mainDlg:newrow()
+  mainDlg:label{ id = "debugStages", text = "Stages p95: n/a" }
+  mainDlg:newrow()
   mainDlg:button{
     id = "refreshDebug",
     text = "Refresh Debug Info",
@@ -539,6 +555,36 @@ function mainDialog.create(viewParams, schedulePreview, rotateModel, updateLayer
       pcall(function()
         mainDlg:modify{ id="debugExport", text = "Last export: (tracking not enabled)" }
       end)
+      local frameCache = AseVoxel.render.frame_cache
+      if frameCache then
+        local fc = frameCache.getStats()
+        pcall(function()
+          mainDlg:modify{ id="debugFrameCache", text = string.format(
+            "Frame cache: %d hits / %d misses, %d frames (%.1f / %.0f MB)",
+            fc.hits, fc.misses, fc.entries, fc.bytes / 1048576, fc.budget / 1048576) }
+        end)
+      end
+      local telemetry = AseVoxel.utils.telemetry
+      if telemetry then
+        local fr = telemetry.getStats("frame")
+        if fr and fr.count > 0 then
+          pcall(function()
+            mainDlg:modify{ id="debugTelemetry", text = string.format(
+              "Frames: p50 %.1f / p95 %.1f / p99 %.1f / max %.1f ms (%d total)",
+              fr.p50, fr.p95, fr.p99, fr.max, fr.total) }
+          end)
+        end
+        local parts = {}
+        for _, st in ipairs({ "transformSort", "draw", "outline", "downsample" }) do
+          local p95 = telemetry.percentile("stage." .. st, 0.95)
+          if p95 then parts[#parts + 1] = string.format("%s %.1f", st, p95) end
+        end
+        if #parts > 0 then
+          pcall(function()
+            mainDlg:modify{ id="debugStages", text = "Stages p95 (ms): " .. table.concat(parts, ", ") }
+          end)
+        end
+      end
     end
   }
   -- Auto-initialize debug info once
@@ -610,6 +656,127 @@ function mainDialog.create(viewParams, schedulePreview, rotateModel, updateLayer
     end
   }
   mainDlg:newrow()
+  mainDlg:check{
+    id = "recordTrace",
+    text = "Record Trace",
+    selected = false,
+    onclick = function()
+      local profiler = AseVoxel.utils.performance_profiler
+      if not profiler then return end
+      if mainDlg.data.recordTrace then
+        -- Spans come from profiler marks, so tracing turns profiling on
+        profiler.startTrace()
+        viewParams.enableProfiling = true
+        mainDlg:modify{ id = "enableProfiling", selected = true }
+      else
+        profiler.stopTrace()
+      end
+    end
+  }
+  mainDlg:button{
+    id = "saveTrace",
+    text = "Save Trace...",
+    onclick = function()
+      local profiler = AseVoxel.utils.performance_profiler
+      local stats = profiler and profiler.getTraceStats()
+      if not stats or stats.events == 0 then
+        app.alert("No trace recorded yet.\n\nCheck 'Record Trace' and interact with the model.")
+        return
+      end
+      local dlg = Dialog("Save Trace")
+      dlg:label{ text = string.format("%d events (%d dropped)", stats.events, stats.dropped) }
+      dlg:file{
+        id = "tracePath",
+        label = "File:",
+        save = true,
+        filename = "asevoxel_trace.json",
+        filetypes = { "json" }
+      }
+      dlg:button{ id = "ok", text = "Save", focus = true }
+      dlg:button{ id = "cancel", text = "Cancel" }
+      dlg:show()
+      local path = dlg.data.tracePath
+      if dlg.data.ok and path and path ~= "" then
+        local ok, err = profiler.writeTrace(path)
+        if not ok then
+          app.alert("Could not write trace: " .. tostring(err))
+        end
+      end
+    end
+  }
+  mainDlg:newrow()
+  mainDlg:check{
+    id = "recordSession",
+    text = "Record Session (for bench/replay.lua)",
+    selected = false,
+    onclick = function()
+      local recorder = AseVoxel.core.session_recorder
+      if not recorder then return end
+      if not mainDlg.data.recordSession then
+        local summary = recorder.stop()
+        if summary then
+          app.alert(string.format("Session saved: %d requests, %d models\n%s",
+            summary.events, summary.models, summary.path))
+        end
+        return
+      end
+      local dlg = Dialog("Record Session")
+      dlg:file{
+        id = "sessionPath",
+        label = "File:",
+        save = true,
+        filename = "asevoxel_session.lua",
+        filetypes = { "lua" }
+      }
+      dlg:button{ id = "ok", text = "Record", focus = true }
+      dlg:button{ id = "cancel", text = "Cancel" }
+      dlg:show()
+      local path = dlg.data.sessionPath
+      local ok, err = false, nil
+      if dlg.data.ok and path and path ~= "" then
+        ok, err = recorder.start(path)
+        if not ok then app.alert("Could not record session: " .. tostring(err)) end
+      end
+      if not ok then mainDlg:modify{ id = "recordSession", selected = false } end
+    end
+  }
+  mainDlg:newrow()
+  mainDlg:check{
+    id = "overdrawOverlay",
+    text = "Overdraw Heatmap (Lua rasterizer)",
+    selected = viewParams.overdrawOverlay or false,
+    onclick = function()
+      viewParams.overdrawOverlay = mainDlg.data.overdrawOverlay or nil
+      if schedulePreview then schedulePreview(false, "overdraw") end
+    end
+  }
+  mainDlg:newrow()
+  mainDlg:label{ id = "overdrawStats", text = "Overdraw: off" }
+  mainDlg:newrow()
+  mainDlg:button{
+    id = "memoryReport",
+    text = "Memory Report",
+    onclick = function()
+      local memoryReport = AseVoxel.utils.memory_report
+      if not memoryReport then return end
+      local viewerCore = AseVoxel.viewerCore
+      local report = memoryReport.collect(previewState and previewState.voxelModel,
+        viewerCore and viewerCore._lastMetrics)
+      local lines = memoryReport.format(report)
+      local dlg = Dialog("Memory Report")
+      for _, line in ipairs(lines) do
+        dlg:label{ text = line }
+        dlg:newrow()
+      end
+      dlg:button{
+        text = "Copy to Clipboard",
+        onclick = function() app.clipboard = table.concat(lines, "\n") end
+      }
+      dlg:button{ text = "Close" }
+      dlg:show()
+    end
+  }
+  mainDlg:newrow()
   
   -- Create the FX tab
   mainDlg:tab{
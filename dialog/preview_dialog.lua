@@ -113,36 +113,8 @@ function previewDialog.create(viewParams, previewCanvasWidth, previewCanvasHeigh
         
         -- Record render time for adaptive throttling (same as OffscreenImage mode)
         local renderTime = (os.clock() * 1000) - startTime
-        if viewerCore and viewerCore._sched then
-          local s = viewerCore._sched
-          if s.dynamicEnabled and renderTime > 0 then
-            local rt = s.renderTimes
-            rt[#rt+1] = renderTime
-            if #rt > s.maxSamples then
-              table.remove(rt, 1)
-            end
-            -- Update adaptive interval using 75th percentile
-            local tmp = {}
-            for i,v in ipairs(rt) do tmp[i] = v end
-            table.sort(tmp)
-            local n = #tmp
-            if n > 0 then
-              local qIndexFloat = 0.75 * (n - 1) + 1
-              local qLow = math.floor(qIndexFloat)
-              local qHigh = math.min(n, qLow + 1)
-              local frac = qIndexFloat - qLow
-              local qVal
-              if qLow == qHigh then
-                qVal = tmp[qLow]
-              else
-                qVal = tmp[qLow] + (tmp[qHigh] - tmp[qLow]) * frac
-              end
-              local desired = qVal * s.dynamicMultiplier
-              if desired < s.dynamicMinMs then desired = s.dynamicMinMs end
-              if desired > s.dynamicMaxMs then desired = s.dynamicMaxMs end
-              s.sampleIntervalMs = math.floor(desired + 0.5)
-            end
-          end
+        if viewerCore and viewerCore.recordRenderTime then
+          viewerCore.recordRenderTime(renderTime)
         end
         
         if not success then
@@ -163,6 +135,11 @@ function previewDialog.create(viewParams, previewCanvasWidth, previewCanvasHeigh
         
         -- Draw the preview image with adjusted position
         ctx:drawImage(previewState.image, finalOffsetX, finalOffsetY)
+
+        -- Overdraw heatmap (Debug tab), same size as the preview image
+        if viewParams.overdrawOverlay and previewState.overdrawImage then
+          ctx:drawImage(previewState.overdrawImage, finalOffsetX, finalOffsetY)
+        end
         
         -- Optionally render debug light cone overlay (pure-pixel, not part of voxel model)
         local showCone = false
@@ -8,6 +8,10 @@ local function getVoxelGenerator()
   return AseVoxel.render.voxel_generator
 end
 
+local function getVoxelBuffer()
+  return AseVoxel.render.voxel_buffer
+end
+
 -- REPLACED exportOBJ: adds Y-axis inversion (sprite Y-down -> OBJ Y-up)
 function exportOBJ.export(voxels, filePath, options)
   local voxelGenerator = getVoxelGenerator()
@@ -59,13 +63,13 @@ function exportOBJ.export(voxels, filePath, options)
   end
 
   local vertOffset = 0
-  for _, v in ipairs(voxels) do
-    local x = v.x * scale
-    local y = ((heightSpan - (v.y - minY)) + minY) * scale
-    local z = v.z * scale
-    local r = (v.color.r or 255)
-    local g = (v.color.g or 255)
-    local b = (v.color.b or 255)
+  local vb = getVoxelBuffer()
+  local buf = vb.of(voxels)
+  for i = 1, buf.n do
+    local x = buf.x[i] * scale
+    local y = ((heightSpan - (buf.y[i] - minY)) + minY) * scale
+    local z = buf.z[i] * scale
+    local r, g, b = vb.unpack(buf.rgba[i])
 
     local matName
     if includeColors and useMaterials then
@@ -3,6 +3,10 @@
 
 local exportPLY = {}
 
+local function getVoxelBuffer()
+  return AseVoxel.render.voxel_buffer
+end
+
 --------------------------------------------------------------------------------
 -- Export the voxel model to PLY format
 -- @param voxels The voxel model to export
@@ -20,19 +24,17 @@ function exportPLY.export(voxels, filePath, options)
   if not plyFile then return false end
 
   -- Y inversion bounds
-  local minY, maxY = math.huge, -math.huge
-  for _, v in ipairs(voxels) do
-    if v.y < minY then minY = v.y end
-    if v.y > maxY then maxY = v.y end
-  end
+  local vb = getVoxelBuffer()
+  local buf = vb.of(voxels)
+  local minY, maxY = buf.minY, buf.maxY
   local heightSpan = maxY - minY
 
   plyFile:write("ply\n")
   plyFile:write("format ascii 1.0\n")
   plyFile:write("comment Generated by Voxel Model Maker for Aseprite\n")
-  plyFile:write("comment Number of voxels: " .. #voxels .. "\n")
-  local numVertices = #voxels * 8
-  local numFaces = #voxels * 12
+  plyFile:write("comment Number of voxels: " .. buf.n .. "\n")
+  local numVertices = buf.n * 8
+  local numFaces = buf.n * 12
   plyFile:write("element vertex " .. numVertices .. "\n")
   plyFile:write("property float x\n")
   plyFile:write("property float y\n")
@@ -48,12 +50,12 @@ function exportPLY.export(voxels, filePath, options)
   local vertexIndex = 0
   
   -- Write vertices
-  for _, voxel in ipairs(voxels) do
+  for i = 1, buf.n do
     -- Create cube vertices (scaled)
-    local x = voxel.x * scaleModel
-    local invY = (heightSpan - (voxel.y - minY)) + minY
+    local x = buf.x[i] * scaleModel
+    local invY = (heightSpan - (buf.y[i] - minY)) + minY
     local y = invY * scaleModel
-    local z = voxel.z * scaleModel
+    local z = buf.z[i] * scaleModel
     local size = scaleModel
     
     -- Define 8 vertices of the cube with color
@@ -67,9 +69,7 @@ function exportPLY.export(voxels, filePath, options)
     local v8 = {x, y + size, z + size}         -- Top-front-left
     
     -- Color for all vertices
-    local r = voxel.color.r
-    local g = voxel.color.g
-    local b = voxel.color.b
+    local r, g, b = vb.unpack(buf.rgba[i])
     
     -- Write vertex positions with colors
     plyFile:write(string.format("%f %f %f %d %d %d\n", v1[1], v1[2], v1[3], r, g, b))
@@ -86,7 +86,7 @@ function exportPLY.export(voxels, filePath, options)
   
   -- Write faces
   vertexIndex = 0
-  for _ in ipairs(voxels) do
+  for _ = 1, buf.n do
     local base = vertexIndex
     
     -- Write faces (triangulated quads - each face is 2 triangles)
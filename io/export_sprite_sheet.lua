@@ -0,0 +1,177 @@
+-- export_sprite_sheet.lua
+-- Directional sprite-sheet baker for game assets: N yaw directions at one or
+-- more elevation angles, rendered from one shared scene in a single batch,
+-- packed row-per-elevation into one sheet with a JSON atlas descriptor.
+
+local exportSpriteSheet = {}
+
+local function getPreviewRenderer()
+  return AseVoxel.previewRenderer
+end
+
+local function getMathUtils()
+  return AseVoxel.mathUtils
+end
+
+--------------------------------------------------------------------------------
+-- Views
+-- view = Pitch(elevation) * (base * Axis(yaw)): the yaw half is built once per
+-- direction and the pitch once per elevation, so each view costs one multiply.
+--------------------------------------------------------------------------------
+local function pitchMatrix(deg)
+  local r = math.rad(deg)
+  local c, s = math.cos(r), math.sin(r)
+  return {
+    {1, 0, 0},
+    {0, c, -s},
+    {0, s, c}
+  }
+end
+
+function exportSpriteSheet.buildViews(options)
+  local mathUtils = getMathUtils()
+  local directions = options.directions or 8
+  local elevations = options.elevations or { 0 }
+  local axis = options.yawAxis or "Y"
+  local startYaw = options.startYaw or 0
+  local base = options.rotationMatrix or mathUtils.createRotationMatrix(
+    options.xRotation or 0, options.yRotation or 0, options.zRotation or 0)
+
+  local yawed = {}
+  for d = 1, directions do
+    local yaw = startYaw + (d - 1) * 360 / directions
+    local ax, ay, az = 0, 0, 0
+    if axis == "X" then ax = yaw elseif axis == "Z" then az = yaw else ay = yaw end
+    yawed[d] = { yaw = yaw % 360,
+                 matrix = mathUtils.multiplyMatrices(base, mathUtils.createRotationMatrix(ax, ay, az)) }
+  end
+
+  local views = {}
+  for row, elevation in ipairs(elevations) do
+    local pitch = pitchMatrix(elevation)
+    for d = 1, directions do
+      local m = mathUtils.multiplyMatrices(pitch, yawed[d].matrix)
+      local e = mathUtils.matrixToEuler(m)
+      views[#views + 1] = {
+        xRotation = e.x, yRotation = e.y, zRotation = e.z, matrix = m,
+        direction = d - 1, yaw = yawed[d].yaw, elevation = elevation, row = row - 1
+      }
+    end
+  end
+  return views
+end
+
+--------------------------------------------------------------------------------
+-- Atlas JSON (fields written in a fixed order so diffs stay readable)
+--------------------------------------------------------------------------------
+local function num(v)
+  if v == math.floor(v) then return string.format("%d", v) end
+  return string.format("%.4g", v)
+end
+
+-- Quoted JSON string (file names may hold quotes, backslashes, controls)
+local JSON_ESCAPES = { ['"'] = '\\"', ['\\'] = '\\\\', ['\n'] = '\\n', ['\r'] = '\\r', ['\t'] = '\\t' }
+local function str(s)
+  return '"' .. tostring(s):gsub('[%c"\\]', function(c)
+    return JSON_ESCAPES[c] or string.format("\\u%04x", c:byte())
+  end) .. '"'
+end
+
+local function atlasJSON(atlas)
+  local out = { "{\n  \"frames\": [\n" }
+  for i, fr in ipairs(atlas.frames) do
+    out[#out + 1] = string.format(
+      "    { \"name\": %s, \"frame\": { \"x\": %d, \"y\": %d, \"w\": %d, \"h\": %d }, " ..
+      "\"direction\": %d, \"yaw\": %s, \"elevation\": %s }%s\n",
+      str(fr.name), fr.x, fr.y, fr.w, fr.h, fr.direction, num(fr.yaw), num(fr.elevation),
+      (i < #atlas.frames) and "," or "")
+  end
+  local m = atlas.meta
+  local elev = {}
+  for i, e in ipairs(m.elevations) do elev[i] = num(e) end
+  out[#out + 1] = string.format(
+    "  ],\n  \"meta\": { \"app\": \"AseVoxel\", \"image\": %s, " ..
+    "\"size\": { \"w\": %d, \"h\": %d }, \"cell\": { \"w\": %d, \"h\": %d }, " ..
+    "\"padding\": %d, \"directions\": %d, \"elevations\": [%s] }\n}\n",
+    str(m.image), m.width, m.height, m.cellWidth, m.cellHeight, m.padding,
+    m.directions, table.concat(elev, ", "))
+  return table.concat(out)
+end
+
+--------------------------------------------------------------------------------
+-- Bake
+-- @param voxels  The voxel model
+-- @param params  Render params shared by every view (scaleLevel, shading, ...)
+-- @param options { directions, elevations = {deg...}, cellWidth, cellHeight,
+--                  padding, yawAxis, startYaw, rotationMatrix | x/y/zRotation,
+--                  path (optional .png; writes path and .json next to it) }
+-- @return sheet Image and atlas table, or nil and an error message
+--------------------------------------------------------------------------------
+function exportSpriteSheet.bake(voxels, params, options)
+  options = options or {}
+  if not voxels or #voxels == 0 then return nil, "No voxels to bake" end
+  local cw = options.cellWidth or 64
+  local ch = options.cellHeight or cw
+  local pad = options.padding or 0
+  local directions = options.directions or 8
+  local elevations = options.elevations or { 0 }
+
+  local views = exportSpriteSheet.buildViews(options)
+  local renderParams = {}
+  for k, v in pairs(params or {}) do renderParams[k] = v end
+  renderParams.width, renderParams.height = cw, ch
+  -- One shared scene, all views in one batch (parallel when native)
+  local images = getPreviewRenderer().renderVoxelModelBatch(voxels, renderParams, views)
+
+  local sheetW = pad + directions * (cw + pad)
+  local sheetH = pad + #elevations * (ch + pad)
+  local sheet = Image(sheetW, sheetH, ColorMode.RGB)
+  local frames = {}
+  for i, v in ipairs(views) do
+    local x = pad + v.direction * (cw + pad)
+    local y = pad + v.row * (ch + pad)
+    local img = images[i]
+    if img then
+      -- Center renders that came back at another size (upscaled backends);
+      -- larger ones are cropped to the cell first so they never bleed into
+      -- the neighbors
+      if img.width > cw or img.height > ch then
+        local cell = Image(cw, ch, ColorMode.RGB)
+        cell:drawImage(img, Point((cw - img.width) // 2, (ch - img.height) // 2))
+        img = cell
+      end
+      sheet:drawImage(img, Point(x + (cw - img.width) // 2, y + (ch - img.height) // 2))
+    end
+    frames[i] = {
+      name = string.format("e%s_d%02d", num(v.elevation), v.direction),
+      x = x, y = y, w = cw, h = ch,
+      direction = v.direction, yaw = v.yaw, elevation = v.elevation
+    }
+  end
+
+  local atlas = {
+    frames = frames,
+    meta = {
+      image = options.path and app.fs.fileName(options.path) or "",
+      width = sheetW, height = sheetH, cellWidth = cw, cellHeight = ch,
+      padding = pad, directions = directions, elevations = elevations
+    }
+  }
+
+  if options.path then
+    local path = options.path
+    if not path:lower():match("%.png$") then path = path .. ".png" end
+    atlas.meta.image = app.fs.fileName(path)
+    local ok, err = AseVoxel.io.export_turntable.writePNG(sheet, path)
+    if not ok then return nil, "Could not write " .. path .. ": " .. tostring(err) end
+    local jsonPath = path:gsub("%.[Pp][Nn][Gg]$", ".json")
+    local f, ferr = io.open(jsonPath, "w")
+    if not f then return nil, "Could not write " .. jsonPath .. ": " .. tostring(ferr) end
+    f:write(atlasJSON(atlas))
+    f:close()
+    atlas.jsonPath = jsonPath
+  end
+  return sheet, atlas
+end
+
+return exportSpriteSheet
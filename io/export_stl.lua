@@ -3,6 +3,10 @@
 
 local exportSTL = {}
 
+local function getVoxelBuffer()
+  return AseVoxel.render.voxel_buffer
+end
+
 --------------------------------------------------------------------------------
 -- Export the voxel model to STL format
 -- @param voxels The voxel model to export
@@ -20,12 +24,10 @@ function exportSTL.export(voxels, filePath, options)
     filePath = filePath .. ".stl"
   end
   
-  -- Compute Y inversion bounds (fixes minY nil error)
-  local minY, maxY = math.huge, -math.huge
-  for _, v in ipairs(voxels) do
-    if v.y < minY then minY = v.y end
-    if v.y > maxY then maxY = v.y end
-  end
+  -- Y inversion bounds (tracked by the packed buffer)
+  local buf = getVoxelBuffer().of(voxels)
+  local X, Y, Z = buf.x, buf.y, buf.z
+  local minY, maxY = buf.minY, buf.maxY
   local heightSpan = maxY - minY
   
   -- Open file for writing
@@ -38,12 +40,12 @@ function exportSTL.export(voxels, filePath, options)
   stlFile:write("solid voxelmodel\n")
   
   -- Process each voxel and output as triangles
-  for _, voxel in ipairs(voxels) do
+  for i = 1, buf.n do
     -- Create cube vertices (scaled and Y-inverted)
-    local x = voxel.x * scaleModel
-    local invY = (heightSpan - (voxel.y - minY)) + minY
+    local x = X[i] * scaleModel
+    local invY = (heightSpan - (Y[i] - minY)) + minY
     local y = invY * scaleModel
-    local z = voxel.z * scaleModel
+    local z = Z[i] * scaleModel
     local size = scaleModel
     
     -- Define 8 vertices of the cube
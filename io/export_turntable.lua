@@ -0,0 +1,522 @@
+-- export_turntable.lua
+-- Streams turntable frames straight to disk as a numbered PNG sequence, an
+-- APNG or a palette GIF, without creating Aseprite frames. Only one rendered
+-- frame is alive at a time, so memory stays flat for any step count. With a
+-- completion callback the export runs from Timer ticks: when the native job
+-- API is available the next frame renders on a worker thread while the
+-- current one is encoded, and the UI thread is free while it waits.
+
+local exportTurntable = {}
+
+local function getPreviewRenderer()
+  return AseVoxel.previewRenderer
+end
+
+--------------------------------------------------------------------------------
+-- Byte output: integers buffered, flushed to the file in string chunks
+--------------------------------------------------------------------------------
+local CHUNK = 4096
+
+local function newSink()
+  return { buf = {}, n = 0, parts = {} }
+end
+
+local function sinkByte(s, b)
+  local n = s.n + 1
+  s.buf[n] = b
+  if n == CHUNK then
+    s.parts[#s.parts + 1] = string.char(table.unpack(s.buf, 1, CHUNK))
+    n = 0
+  end
+  s.n = n
+end
+
+local function sinkString(s)
+  if s.n > 0 then
+    s.parts[#s.parts + 1] = string.char(table.unpack(s.buf, 1, s.n))
+    s.n = 0
+  end
+  local out = table.concat(s.parts)
+  s.parts = {}
+  return out
+end
+
+--------------------------------------------------------------------------------
+-- Frame pixels: RGBA rows into a reused byte array
+--------------------------------------------------------------------------------
+local _rgba = {}
+
+-- Fills _rgba with width*height*4 bytes (pixels outside the image are clear)
+local function readPixels(image, width, height)
+  local pc = app.pixelColor
+  local iw, ih = image.width, image.height
+  local k = 0
+  for y = 0, height - 1 do
+    for x = 0, width - 1 do
+      local r, g, b, a = 0, 0, 0, 0
+      if x < iw and y < ih then
+        local px = image:getPixel(x, y)
+        r, g, b, a = pc.rgbaR(px), pc.rgbaG(px), pc.rgbaB(px), pc.rgbaA(px)
+      end
+      _rgba[k + 1], _rgba[k + 2], _rgba[k + 3], _rgba[k + 4] = r, g, b, a
+      k = k + 4
+    end
+  end
+  return _rgba
+end
+
+--------------------------------------------------------------------------------
+-- zlib stream: fixed-Huffman deflate with greedy LZ77 (32K window)
+--------------------------------------------------------------------------------
+local LBASE = {3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258}
+local LEXT  = {0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0}
+local DBASE = {1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,
+               1025,1537,2049,3073,4097,6145,8193,12289,16385,24577}
+local DEXT  = {0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13}
+
+local _litCode, _litBits       -- reversed fixed codes for symbols 0..287
+local _lenSym, _distSym        -- match length / distance -> table index
+
+local function reverseBits(v, n)
+  local r = 0
+  for _ = 1, n do
+    r = (r << 1) | (v & 1)
+    v = v >> 1
+  end
+  return r
+end
+
+local function initTables()
+  if _litCode then return end
+  _litCode, _litBits = {}, {}
+  for sym = 0, 287 do
+    local code, bits
+    if sym <= 143 then code, bits = 0x30 + sym, 8
+    elseif sym <= 255 then code, bits = 0x190 + sym - 144, 9
+    elseif sym <= 279 then code, bits = sym - 256, 7
+    else code, bits = 0xC0 + sym - 280, 8 end
+    _litCode[sym] = reverseBits(code, bits)
+    _litBits[sym] = bits
+  end
+  -- Length 258 has its own symbol (285); 227..257 use 284's extra bits
+  _lenSym = {}
+  for i = 1, #LBASE do
+    local top = (i < #LBASE) and (LBASE[i + 1] - 1) or 258
+    if i == #LBASE - 1 then top = 257 end
+    for len = LBASE[i], top do _lenSym[len] = i end
+  end
+  _distSym = {}
+  for i = 1, #DBASE do
+    local top = (i == #DBASE) and 32768 or (DBASE[i + 1] - 1)
+    for d = DBASE[i], top do _distSym[d] = i end
+  end
+end
+
+local MAX_MATCH, WINDOW = 258, 32768
+
+-- data: byte array [1..n]; appends a complete zlib stream to sink
+local function zlibCompress(sink, data, n)
+  initTables()
+  local bitBuf, bitCnt = 0, 0
+  local function putBits(v, cnt)
+    bitBuf = bitBuf | (v << bitCnt)
+    bitCnt = bitCnt + cnt
+    while bitCnt >= 8 do
+      sinkByte(sink, bitBuf & 0xFF)
+      bitBuf = bitBuf >> 8
+      bitCnt = bitCnt - 8
+    end
+  end
+
+  sinkByte(sink, 0x78); sinkByte(sink, 0x01)
+  putBits(1, 1)   -- BFINAL
+  putBits(1, 2)   -- BTYPE = fixed Huffman
+
+  local litCode, litBits = _litCode, _litBits
+  local head = {}   -- 3-byte value -> last position, this stream only
+  local i = 1
+  while i <= n do
+    local bestLen = 0
+    local dist = 0
+    if i + 2 <= n then
+      local h = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2]
+      local cand = head[h]
+      head[h] = i
+      if cand and cand < i and i - cand <= WINDOW then
+        local maxLen = math.min(MAX_MATCH, n - i + 1)
+        local l = 0
+        while l < maxLen and data[cand + l] == data[i + l] do l = l + 1 end
+        if l >= 3 then bestLen, dist = l, i - cand end
+      end
+    end
+    if bestLen > 0 then
+      local li = _lenSym[bestLen]
+      local sym = 256 + li
+      putBits(litCode[sym], litBits[sym])
+      if LEXT[li] > 0 then putBits(bestLen - LBASE[li], LEXT[li]) end
+      local di = _distSym[dist]
+      putBits(reverseBits(di - 1, 5), 5)
+      if DEXT[di] > 0 then putBits(dist - DBASE[di], DEXT[di]) end
+      -- Seed the hash inside the match so later runs can find it
+      local stop = math.min(i + bestLen - 1, n - 2)
+      for j = i + 1, stop do
+        head[(data[j] << 16) | (data[j + 1] << 8) | data[j + 2]] = j
+      end
+      i = i + bestLen
+    else
+      local b = data[i]
+      putBits(litCode[b], litBits[b])
+      i = i + 1
+    end
+  end
+  putBits(litCode[256], litBits[256])
+  if bitCnt > 0 then putBits(0, 8 - bitCnt) end
+
+  -- Adler-32 of the uncompressed data
+  local a, b = 1, 0
+  for k = 1, n do
+    a = (a + data[k]) % 65521
+    b = (b + a) % 65521
+  end
+  sinkByte(sink, (b >> 8) & 0xFF); sinkByte(sink, b & 0xFF)
+  sinkByte(sink, (a >> 8) & 0xFF); sinkByte(sink, a & 0xFF)
+end
+
+--------------------------------------------------------------------------------
+-- PNG / APNG chunks
+--------------------------------------------------------------------------------
+local _crcTable
+
+local function crc32(s)
+  if not _crcTable then
+    _crcTable = {}
+    for i = 0, 255 do
+      local c = i
+      for _ = 1, 8 do
+        if c & 1 == 1 then c = 0xEDB88320 ~ (c >> 1) else c = c >> 1 end
+      end
+      _crcTable[i] = c
+    end
+  end
+  local c = 0xFFFFFFFF
+  for k = 1, #s do
+    c = _crcTable[(c ~ s:byte(k)) & 0xFF] ~ (c >> 8)
+  end
+  return c ~ 0xFFFFFFFF
+end
+
+local function writeChunk(f, ctype, data)
+  f:write(string.pack(">I4", #data), ctype, data, string.pack(">I4", crc32(ctype .. data)))
+end
+
+local PNG_SIGNATURE = "\137PNG\r\n\26\n"
+
+-- Scanlines (filter 0) + zlib for one RGBA frame
+local _scan = {}
+local function pngFrameData(image, width, height)
+  local px = readPixels(image, width, height)
+  local rowBytes = width * 4
+  local k, s = 0, 0
+  for _ = 1, height do
+    k = k + 1
+    _scan[k] = 0
+    for j = 1, rowBytes do _scan[k + j] = px[s + j] end
+    k = k + rowBytes
+    s = s + rowBytes
+  end
+  local sink = newSink()
+  zlibCompress(sink, _scan, k)
+  return sinkString(sink)
+end
+
+local function ihdr(width, height)
+  return string.pack(">I4I4BBBBB", width, height, 8, 6, 0, 0, 0)
+end
+
+--------------------------------------------------------------------------------
+-- Writers: begin(path, width, height, count, delayMs) -> writer with
+-- writer:frame(image, index) and writer:finish()
+--------------------------------------------------------------------------------
+local writers = {}
+
+-- Numbered PNG files: name.png -> name_0001.png, name_0002.png, ...
+function writers.png(path, width, height, count)
+  local stem = path:gsub("%.[Pp][Nn][Gg]$", "")
+  local digits = math.max(4, #tostring(count))
+  local w = { files = {} }
+  function w:frame(image, index)
+    local name = string.format("%s_%0" .. digits .. "d.png", stem, index)
+    local f, err = io.open(name, "wb")
+    if not f then error("Could not open " .. name .. ": " .. tostring(err)) end
+    f:write(PNG_SIGNATURE)
+    writeChunk(f, "IHDR", ihdr(width, height))
+    writeChunk(f, "IDAT", pngFrameData(image, width, height))
+    writeChunk(f, "IEND", "")
+    f:close()
+    self.files[#self.files + 1] = name
+  end
+  function w:finish() return self.files end
+  return w
+end
+
+-- Animated PNG: frame 1 is the default image (IDAT), later frames are fdAT
+function writers.apng(path, width, height, count, delayMs)
+  if not path:lower():match("%.a?png$") then path = path .. ".png" end
+  local f, err = io.open(path, "wb")
+  if not f then error("Could not open " .. path .. ": " .. tostring(err)) end
+  f:write(PNG_SIGNATURE)
+  writeChunk(f, "IHDR", ihdr(width, height))
+  writeChunk(f, "acTL", string.pack(">I4I4", count, 0))
+  local w = { seq = 0 }
+  function w:frame(image, index)
+    -- dispose NONE + blend SOURCE: every frame fully replaces the canvas
+    writeChunk(f, "fcTL", string.pack(">I4I4I4I4I4I2I2BB",
+      self.seq, width, height, 0, 0, math.floor(delayMs + 0.5), 1000, 0, 0))
+    self.seq = self.seq + 1
+    local data = pngFrameData(image, width, height)
+    if index == 1 then
+      writeChunk(f, "IDAT", data)
+    else
+      writeChunk(f, "fdAT", string.pack(">I4", self.seq) .. data)
+      self.seq = self.seq + 1
+    end
+  end
+  function w:finish()
+    writeChunk(f, "IEND", "")
+    f:close()
+    return { path }
+  end
+  return w
+end
+
+--------------------------------------------------------------------------------
+-- GIF: fixed 256-entry palette (index 0 transparent, 6x6x6 cube, 39 grays)
+--------------------------------------------------------------------------------
+local GRAY_LEVELS = 39
+local GRAY_BASE = 217
+
+local function gifPalette()
+  local t = { string.char(0, 0, 0) }
+  for r = 0, 5 do
+    for g = 0, 5 do
+      for b = 0, 5 do
+        t[#t + 1] = string.char(r * 51, g * 51, b * 51)
+      end
+    end
+  end
+  for i = 0, GRAY_LEVELS - 1 do
+    local l = math.floor(i * 255 / (GRAY_LEVELS - 1) + 0.5)
+    t[#t + 1] = string.char(l, l, l)
+  end
+  return table.concat(t)
+end
+
+local _indices = {}
+local function quantize(image, width, height)
+  local px = readPixels(image, width, height)
+  local n = width * height
+  for i = 1, n do
+    local k = (i - 1) * 4
+    local r, g, b, a = px[k + 1], px[k + 2], px[k + 3], px[k + 4]
+    if a < 128 then
+      _indices[i] = 0
+    else
+      local hi = math.max(r, g, b)
+      local lo = math.min(r, g, b)
+      if hi - lo < 12 then
+        _indices[i] = GRAY_BASE + math.floor((r + g + b) / 3 * (GRAY_LEVELS - 1) / 255 + 0.5)
+      else
+        _indices[i] = 1 + (r * 5 + 127) // 255 * 36 + (g * 5 + 127) // 255 * 6 + (b * 5 + 127) // 255
+      end
+    end
+  end
+  return _indices, n
+end
+
+-- Variable-width LZW (min code size 8) in 255-byte sub-blocks
+local function lzwEncode(f, indices, n)
+  local CLEAR, EOI = 256, 257
+  local sink = newSink()
+  local bitBuf, bitCnt = 0, 0
+  local codeSize = 9
+  local function put(code)
+    bitBuf = bitBuf | (code << bitCnt)
+    bitCnt = bitCnt + codeSize
+    while bitCnt >= 8 do
+      sinkByte(sink, bitBuf & 0xFF)
+      bitBuf = bitBuf >> 8
+      bitCnt = bitCnt - 8
+    end
+  end
+
+  local dict = {}
+  local nextCode = 258
+  -- Widen after the code that the decoder's next table entry will overflow
+  local function emit(code)
+    put(code)
+    if nextCode >= (1 << codeSize) and codeSize < 12 then codeSize = codeSize + 1 end
+  end
+  put(CLEAR)
+  local prefix = indices[1]
+  for i = 2, n do
+    local c = indices[i]
+    local key = prefix * 256 + c
+    local code = dict[key]
+    if code then
+      prefix = code
+    else
+      emit(prefix)
+      if nextCode < 4096 then
+        dict[key] = nextCode
+        nextCode = nextCode + 1
+      else
+        put(CLEAR)
+        dict = {}
+        nextCode = 258
+        codeSize = 9
+      end
+      prefix = c
+    end
+  end
+  emit(prefix)
+  put(EOI)
+  if bitCnt > 0 then sinkByte(sink, bitBuf & 0xFF) end
+
+  local data = sinkString(sink)
+  f:write(string.char(8))
+  for p = 1, #data, 255 do
+    local block = data:sub(p, p + 254)
+    f:write(string.char(#block), block)
+  end
+  f:write(string.char(0))
+end
+
+function writers.gif(path, width, height, count, delayMs)
+  if not path:lower():match("%.gif$") then path = path .. ".gif" end
+  local f, err = io.open(path, "wb")
+  if not f then error("Could not open " .. path .. ": " .. tostring(err)) end
+  f:write("GIF89a", string.pack("<I2I2BBB", width, height, 0xF7, 0, 0))
+  f:write(gifPalette())
+  -- Loop forever (NETSCAPE2.0 application extension)
+  f:write("\33\255\11NETSCAPE2.0\3\1", string.pack("<I2", 0), "\0")
+  local delayCs = math.max(2, math.floor(delayMs / 10 + 0.5))
+  local w = {}
+  function w:frame(image)
+    -- Graphic control: dispose to background, index 0 transparent
+    f:write("\33\249\4", string.char(0x09), string.pack("<I2", delayCs), "\0\0")
+    f:write(",", string.pack("<I2I2I2I2B", 0, 0, width, height, 0))
+    local indices, n = quantize(image, width, height)
+    lzwEncode(f, indices, n)
+  end
+  function w:finish()
+    f:write(";")
+    f:close()
+    return { path }
+  end
+  return w
+end
+
+exportTurntable.FORMATS = { "png", "apng", "gif" }
+
+-- Single RGBA PNG (shared with the sprite-sheet baker)
+function exportTurntable.writePNG(image, path)
+  local f, err = io.open(path, "wb")
+  if not f then return false, err end
+  f:write(PNG_SIGNATURE)
+  writeChunk(f, "IHDR", ihdr(image.width, image.height))
+  writeChunk(f, "IDAT", pngFrameData(image, image.width, image.height))
+  writeChunk(f, "IEND", "")
+  f:close()
+  return true
+end
+
+--------------------------------------------------------------------------------
+-- Export a turntable
+-- @param voxels   The voxel model
+-- @param params   Render params shared by every frame (width/height required)
+-- @param views    Array of { xRotation, yRotation, zRotation }
+-- @param options  { format = "png"|"apng"|"gif", path, delayMs, onProgress(i, n),
+--                   onDone(files, err) }
+-- @return list of written files, or nil and an error message. With
+--   options.onDone (and Timer) it returns true at once and streams from Timer
+--   ticks; onDone then receives the files or nil and the error.
+--------------------------------------------------------------------------------
+local TICK_SEC = 0.01
+
+function exportTurntable.export(voxels, params, views, options)
+  options = options or {}
+  local begin = writers[options.format or "png"]
+  if not begin then return nil, "Unsupported turntable format: " .. tostring(options.format) end
+  if not options.path or options.path == "" then return nil, "No output path" end
+  local count = #views
+  if count == 0 then return nil, "No frames" end
+  local width = params.width or 200
+  local height = params.height or 200
+
+  local previewRenderer = getPreviewRenderer()
+  local function frameParams(i)
+    local p = {}
+    for k, v in pairs(params) do p[k] = v end
+    local v = views[i]
+    p.x, p.y, p.z = nil, nil, nil
+    p.xRotation, p.yRotation, p.zRotation = v.xRotation or 0, v.yRotation or 0, v.zRotation or 0
+    p.noFrameCache = true   -- streamed frames would only flush the cache
+    return p
+  end
+
+  local writer
+  local function emit(i, image)
+    if not image then error("Render failed at frame " .. i) end
+    writer:frame(image, i)
+    if options.onProgress then options.onProgress(i, count) end
+  end
+
+  -- Blocking: frames render one after another on this thread
+  if not (options.onDone and Timer) then
+    local ok, result = pcall(function()
+      writer = begin(options.path, width, height, count, options.delayMs or 40)
+      for i = 1, count do
+        emit(i, previewRenderer.renderVoxelModel(voxels, frameParams(i)))
+      end
+      return writer:finish()
+    end)
+    if not ok then return nil, tostring(result) end
+    return result
+  end
+
+  -- Streaming: each tick takes the next finished frame (rendering it inline
+  -- when there is no native job), starts the one after it and encodes. A tick
+  -- whose job is still running returns instead of waiting on it.
+  local nextFrame, pending, timer = 1, nil, nil
+  local function start(i)
+    local p = frameParams(i)
+    return { job = previewRenderer.submitVoxelModel(voxels, p), params = p }
+  end
+  local function tick()
+    local ok, result = pcall(function()
+      if not writer then
+        writer = begin(options.path, width, height, count, options.delayMs or 40)
+        pending = start(1)
+      end
+      local job = pending.job
+      local st = job and job:poll()
+      if st == "running" then return nil end
+      local image = (st == "done") and job:result() or nil
+      if not image then image = previewRenderer.renderVoxelModel(voxels, pending.params) end
+      local i = nextFrame
+      nextFrame = i + 1
+      pending = (nextFrame <= count) and start(nextFrame) or nil
+      emit(i, image)
+      if nextFrame > count then return writer:finish() end
+      return nil
+    end)
+    if ok and not result then return end
+    timer:stop()
+    if ok then options.onDone(result) else options.onDone(nil, tostring(result)) end
+  end
+  timer = Timer{ interval = TICK_SEC, ontick = tick }
+  timer:start()
+  return true
+end
+
+return exportTurntable
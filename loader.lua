@@ -94,6 +94,7 @@ print("[AseVoxel] Layer 1 complete: trackball, rotation_matrix, rotation")
 print("[AseVoxel] Loading Layer 2: Rendering Core...")
 
 -- Standalone render modules (no dependencies or minimal)
+AseVoxel.render.voxel_buffer = loadModule("render" .. sep .. "voxel_buffer")
 AseVoxel.render.native_bridge = loadModule("render" .. sep .. "native_bridge")
 AseVoxel.render.remote_renderer = loadModule("render" .. sep .. "remote_renderer")
 AseVoxel.render.fx_stack = loadModule("render" .. sep .. "fx_stack")
@@ -104,6 +105,11 @@ AseVoxel.render.mesh_renderer = loadModule("render" .. sep .. "mesh_renderer")
 AseVoxel.render.face_visibility = loadModule("render" .. sep .. "face_visibility")
 AseVoxel.render.fast_visibility = loadModule("render" .. sep .. "fast_visibility")
 AseVoxel.render.vertex_cache = loadModule("render" .. sep .. "vertex_cache")
+AseVoxel.render.brick_cache = loadModule("render" .. sep .. "brick_cache")
+AseVoxel.render.depth_sort = loadModule("render" .. sep .. "depth_sort")
+AseVoxel.render.oit = loadModule("render" .. sep .. "oit")
+AseVoxel.render.overdraw = loadModule("render" .. sep .. "overdraw")
+AseVoxel.render.frame_cache = loadModule("render" .. sep .. "frame_cache")
 AseVoxel.render.rasterizer = loadModule("render" .. sep .. "rasterizer")
 AseVoxel.render.shading = loadModule("render" .. sep .. "shading")
 AseVoxel.render.mesh_pipeline = loadModule("render" .. sep .. "mesh_pipeline")
@@ -124,9 +130,12 @@ AseVoxel.io.file_common = loadModule("io" .. sep .. "file_common")
 AseVoxel.io.export_obj = loadModule("io" .. sep .. "export_obj")
 AseVoxel.io.export_ply = loadModule("io" .. sep .. "export_ply")
 AseVoxel.io.export_stl = loadModule("io" .. sep .. "export_stl")
+AseVoxel.io.export_turntable = loadModule("io" .. sep .. "export_turntable")
+AseVoxel.io.export_sprite_sheet = loadModule("io" .. sep .. "export_sprite_sheet")
 
 -- Add voxel_generator to render namespace
 AseVoxel.render.voxel_generator = loadModule("render" .. sep .. "voxel_generator")
+AseVoxel.render.timeline_cache = loadModule("render" .. sep .. "timeline_cache")
 
 print("[AseVoxel] Layer 3 complete: file I/O and voxel generation")
 
@@ -139,6 +148,7 @@ AseVoxel.core.sprite_watcher = loadModule("core" .. sep .. "sprite_watcher")
 AseVoxel.core.preview_manager = loadModule("core" .. sep .. "preview_manager")
 AseVoxel.core.viewer_core = loadModule("core" .. sep .. "viewer_core")
 AseVoxel.core.viewer_state = loadModule("core" .. sep .. "viewer_state")
+AseVoxel.core.session_recorder = loadModule("core" .. sep .. "session_recorder")
 
 print("[AseVoxel] Layer 4 complete: core application logic")
 
@@ -151,6 +161,8 @@ print("[AseVoxel] Loading Layer 5: Utilities...")
 AseVoxel.utils.preview_utils = loadModule("utils" .. sep .. "preview_utils")
 AseVoxel.utils.dialog_utils = loadModule("utils" .. sep .. "dialog_utils")
 AseVoxel.utils.performance_profiler = loadModule("utils" .. sep .. "performance_profiler")
+AseVoxel.utils.telemetry = loadModule("utils" .. sep .. "telemetry")
+AseVoxel.utils.memory_report = loadModule("utils" .. sep .. "memory_report")
 
 print("[AseVoxel] Layer 5 complete: utilities")
 
@@ -202,8 +214,10 @@ AseVoxel.spriteWatcher = AseVoxel.core.sprite_watcher
 AseVoxel.previewManager = AseVoxel.core.preview_manager
 AseVoxel.viewerCore = AseVoxel.core.viewer_core
 AseVoxel.viewerState = AseVoxel.core.viewer_state
+AseVoxel.sessionRecorder = AseVoxel.core.session_recorder
 AseVoxel.previewUtils = AseVoxel.utils.preview_utils
 AseVoxel.dialogUtils = AseVoxel.utils.dialog_utils
+AseVoxel.telemetry = AseVoxel.utils.telemetry
 
 -- Dialog modules
 AseVoxel.dialogManager = AseVoxel.dialog.dialog_manager
@@ -221,6 +235,8 @@ AseVoxel.fileUtils = AseVoxel.io.file_common
 AseVoxel.exportOBJ = AseVoxel.io.export_obj
 AseVoxel.exportPLY = AseVoxel.io.export_ply
 AseVoxel.exportSTL = AseVoxel.io.export_stl
+AseVoxel.exportTurntable = AseVoxel.io.export_turntable
+AseVoxel.exportSpriteSheet = AseVoxel.io.export_sprite_sheet
 
 -- Create convenience mathUtils-style namespace for compatibility
 AseVoxel.mathUtils = {
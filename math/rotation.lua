@@ -10,6 +10,10 @@ local function getMathUtils()
 end
 
 -- Try to load native bridge (optional)
+local function getVoxelBuffer()
+  return AseVoxel.render.voxel_buffer
+end
+
 local function getNativeBridge()
   if AseVoxel and AseVoxel.render and AseVoxel.render.native_bridge then
     return AseVoxel.render.native_bridge
@@ -171,33 +175,37 @@ end
 -- @return Optimized voxel model with hidden face information
 --------------------------------------------------------------------------------
 function rotation.optimizeVoxelModel(voxels)
-  -- Create a map of voxel positions for quick lookup
+  -- Occupancy by numeric coordinate key, read from the model's packed buffer
+  local vb = getVoxelBuffer()
+  local buf = vb.of(voxels)
+  local X, Y, Z = buf.x, buf.y, buf.z
+  local key = vb.key
   local voxelMap = {}
-  for _, voxel in ipairs(voxels) do
-    local key = voxel.x .. "," .. voxel.y .. "," .. voxel.z
-    voxelMap[key] = true
+  for i = 1, buf.n do
+    voxelMap[key(X[i], Y[i], Z[i])] = true
   end
   
   -- Create optimized model with hidden face information
   local optimized = {}
   
-  for _, voxel in ipairs(voxels) do
+  for i, voxel in ipairs(voxels) do
     -- Check all six neighbors to determine which faces are hidden
     -- A face is hidden if there's a neighboring voxel on that face
+    local x, y, z = X[i], Y[i], Z[i]
     local hiddenFaces = {
-      front = voxelMap[(voxel.x) .. "," .. (voxel.y) .. "," .. (voxel.z + 1)] or false,
-      back = voxelMap[(voxel.x) .. "," .. (voxel.y) .. "," .. (voxel.z - 1)] or false,
-      right = voxelMap[(voxel.x + 1) .. "," .. (voxel.y) .. "," .. (voxel.z)] or false,
-      left = voxelMap[(voxel.x - 1) .. "," .. (voxel.y) .. "," .. (voxel.z)] or false,
-      top = voxelMap[(voxel.x) .. "," .. (voxel.y + 1) .. "," .. (voxel.z)] or false,
-      bottom = voxelMap[(voxel.x) .. "," .. (voxel.y - 1) .. "," .. (voxel.z)] or false
+      front = voxelMap[key(x, y, z + 1)] or false,
+      back = voxelMap[key(x, y, z - 1)] or false,
+      right = voxelMap[key(x + 1, y, z)] or false,
+      left = voxelMap[key(x - 1, y, z)] or false,
+      top = voxelMap[key(x, y + 1, z)] or false,
+      bottom = voxelMap[key(x, y - 1, z)] or false
     }
     
     -- Add to optimized model
-    table.insert(optimized, {
+    optimized[i] = {
       voxel = voxel,
       hiddenFaces = hiddenFaces
-    })
+    }
   end
   
   return optimized
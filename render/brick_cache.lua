@@ -0,0 +1,454 @@
+-- brick_cache.lua
+-- Chunked 16x16x16 brick storage for voxel models.
+-- Each brick keeps its bounds, occupancy (cell -> packed RGBA), a content
+-- hash and a surface list (cells with at least one exposed face + their
+-- hidden-face masks). Bricks read the model's voxel_buffer arrays and hold
+-- no per-voxel tables.
+-- Bricks are rebuilt only when their contents (or a face neighbor) change,
+-- and whole bricks can be culled against the viewport in a single test.
+-- The concatenated surface lists form the model's shell, which every render
+-- path consumes instead of the full model (interior voxels never draw).
+
+local brickCache = {}
+
+brickCache.BRICK_SIZE = 16
+local BS = 16
+local BS2 = BS * BS
+
+local floor = math.floor
+
+local function getVoxelBuffer()
+  return AseVoxel.render.voxel_buffer
+end
+
+-- Packed integer brick key (brick coords are small; +512 keeps them positive)
+local KEY_BIAS = 512
+local KEY_SPAN = 1024
+local function brickKey(bx, by, bz)
+  return ((bx + KEY_BIAS) * KEY_SPAN + (by + KEY_BIAS)) * KEY_SPAN + (bz + KEY_BIAS)
+end
+
+-- Face neighbor offsets (names match rotation.optimizeVoxelModel; bits are
+-- the renderer's face mask bits)
+local FACE_OFFSETS = {
+  { name = "front",  dx = 0,  dy = 0,  dz = 1,  bit = 1  },
+  { name = "back",   dx = 0,  dy = 0,  dz = -1, bit = 2  },
+  { name = "right",  dx = 1,  dy = 0,  dz = 0,  bit = 4  },
+  { name = "left",   dx = -1, dy = 0,  dz = 0,  bit = 8  },
+  { name = "top",    dx = 0,  dy = 1,  dz = 0,  bit = 16 },
+  { name = "bottom", dx = 0,  dy = -1, dz = 0,  bit = 32 }
+}
+
+-- Shared read-only {front=bool,...} per hidden-face mask, for callers that
+-- still take face tables
+local HIDDEN_FACES = {}
+for m = 0, 63 do
+  local t = {}
+  for _, f in ipairs(FACE_OFFSETS) do t[f.name] = (m & f.bit) ~= 0 end
+  HIDDEN_FACES[m] = t
+end
+function brickCache.hiddenFaces(mask)
+  return HIDDEN_FACES[mask or 0]
+end
+
+-- Grids per model table (weak) + last grid for incremental diffing
+local _byModel = setmetatable({}, { __mode = "k" })
+local _last = nil
+
+local _stats = { updates = 0, identityHits = 0, bricksRebuilt = 0, bricksReused = 0 }
+
+--------------------------------------------------------------------------------
+-- Hashing
+--------------------------------------------------------------------------------
+function brickCache.packColor(c)
+  return getVoxelBuffer().packColor(c)
+end
+
+-- Order-independent per-voxel mix (summed per brick; integer math wraps)
+local function voxelHash(x, y, z, rgba)
+  local h = x * 73856093 ~ y * 19349663 ~ z * 83492791
+  h = h * 2654435761 + rgba * 40503
+  return h ~ (h >> 29)
+end
+
+--------------------------------------------------------------------------------
+-- Surface extraction for one brick (needs neighbor bricks for border voxels)
+--------------------------------------------------------------------------------
+-- Cell index inside a brick: x + y*16 + z*256 (local coordinates)
+local function cellXYZ(b, c)
+  return b.ox + c % BS, b.oy + (c // BS) % BS, b.oz + c // BS2
+end
+brickCache.cellXYZ = cellXYZ
+
+-- Packed RGBA of the voxel at x, y, z, or nil
+local function occupancy(bricks, x, y, z)
+  local bx, by, bz = x // BS, y // BS, z // BS
+  local b = bricks[brickKey(bx, by, bz)]
+  if not b then return nil end
+  return b.occ[(x - bx * BS) + (y - by * BS) * BS + (z - bz * BS) * BS2]
+end
+
+local function rebuildSurface(brick, bricks)
+  local surface, masks = {}, {}
+  local occ = brick.occ
+  for _, c in ipairs(brick.cells) do
+    local x, y, z = cellXYZ(brick, c)
+    local glass = (occ[c] & 0xFF) < 255
+    local mask = 0
+    for _, f in ipairs(FACE_OFFSETS) do
+      -- A translucent neighbor only hides faces of other translucent voxels
+      local nb = occupancy(bricks, x + f.dx, y + f.dy, z + f.dz)
+      if nb and (glass or (nb & 0xFF) == 255) then mask = mask | f.bit end
+    end
+    if mask ~= 63 then
+      surface[#surface + 1] = c
+      masks[#masks + 1] = mask
+    end
+  end
+  brick.surface = surface
+  brick.surfaceMask = masks
+end
+
+--------------------------------------------------------------------------------
+-- Build / update
+--------------------------------------------------------------------------------
+-- Same value as the grid fingerprint for a plain model table, without
+-- bucketing (no allocation)
+local function modelFingerprint(model, n)
+  local packColor = getVoxelBuffer().packColor
+  local sum = 0
+  for i = 1, n do
+    local v = model[i]
+    sum = sum + voxelHash(floor(v.x), floor(v.y), floor(v.z), packColor(v.color))
+  end
+  return n + sum * 31
+end
+
+-- Buckets the model into bricks, reusing unchanged bricks from the previous
+-- grid and re-extracting surfaces only where contents changed.
+-- Returns grid = { bricks, list, voxelCount, shellCount, fingerprint, bounds,
+-- rebuilt }
+-- brick = { key, bx, by, bz, ox, oy, oz, count, hash, translucent, bounds,
+--           cells, occ, surface, surfaceMask }
+function brickCache.update(model)
+  if not model then return nil end
+  local vb = getVoxelBuffer()
+  local buf = vb.backing(model)
+  local n = buf and buf.n or #model
+  local cached = _byModel[model]
+  -- Proxy models are immutable; plain tables are fingerprinted to catch
+  -- in-place edits that keep the voxel count
+  if cached and cached.voxelCount == n
+     and (buf or cached.fingerprint == modelFingerprint(model, n)) then
+    _stats.identityHits = _stats.identityHits + 1
+    if not cached.lod then _last = cached end
+    return cached
+  end
+  _stats.updates = _stats.updates + 1
+  if not buf then
+    buf = vb.fromModel(model)
+    vb.attach(model, buf)
+  end
+  local X, Y, Z, RGBA = buf.x, buf.y, buf.z, buf.rgba
+
+  -- 1. Bucket voxels into fresh brick stubs (idx = buffer indices)
+  local stubs, stubList = {}, {}
+  local minX, minY, minZ = math.huge, math.huge, math.huge
+  local maxX, maxY, maxZ = -math.huge, -math.huge, -math.huge
+  for i = 1, n do
+    local x, y, z = floor(X[i]), floor(Y[i]), floor(Z[i])
+    local bx, by, bz = x // BS, y // BS, z // BS
+    local key = brickKey(bx, by, bz)
+    local s = stubs[key]
+    if not s then
+      s = {
+        key = key, bx = bx, by = by, bz = bz,
+        ox = bx * BS, oy = by * BS, oz = bz * BS,
+        idx = {}, count = 0, hash = 0, translucent = false,
+        minX = math.huge, minY = math.huge, minZ = math.huge,
+        maxX = -math.huge, maxY = -math.huge, maxZ = -math.huge
+      }
+      stubs[key] = s
+      stubList[#stubList + 1] = s
+    end
+    local count = s.count + 1
+    s.count = count
+    s.idx[count] = i
+    local rgba = RGBA[i]
+    s.hash = s.hash + voxelHash(x, y, z, rgba)
+    if rgba & 0xFF < 255 then s.translucent = true end
+    if x < s.minX then s.minX = x end
+    if x > s.maxX then s.maxX = x end
+    if y < s.minY then s.minY = y end
+    if y > s.maxY then s.maxY = y end
+    if z < s.minZ then s.minZ = z end
+    if z > s.maxZ then s.maxZ = z end
+  end
+
+  -- 2. Reuse unchanged bricks; collect changed keys. New bricks swap their
+  -- buffer indices for local cells so they never point back at the buffer.
+  local prev = _last and _last.bricks or {}
+  local bricks, list = {}, {}
+  local changed = {}
+  local adopted = {}   -- key -> list index of bricks shared with older grids
+  local fingerprint = n
+  local translucent = false
+  for _, s in ipairs(stubList) do
+    local old = prev[s.key]
+    if old and old.hash == s.hash and old.count == s.count then
+      bricks[s.key] = old
+      list[#list + 1] = old
+      adopted[s.key] = #list
+    else
+      local cells, occ = {}, {}
+      local ox, oy, oz = s.ox, s.oy, s.oz
+      for k, i in ipairs(s.idx) do
+        local c = (floor(X[i]) - ox) + (floor(Y[i]) - oy) * BS + (floor(Z[i]) - oz) * BS2
+        cells[k] = c
+        occ[c] = RGBA[i]
+      end
+      s.cells, s.occ = cells, occ
+      bricks[s.key] = s
+      list[#list + 1] = s
+      changed[#changed + 1] = s
+    end
+    s.idx = nil
+    fingerprint = fingerprint + s.hash * 31
+    if s.translucent then translucent = true end
+    if s.minX < minX then minX = s.minX end
+    if s.maxX > maxX then maxX = s.maxX end
+    if s.minY < minY then minY = s.minY end
+    if s.maxY > maxY then maxY = s.maxY end
+    if s.minZ < minZ then minZ = s.minZ end
+    if s.maxZ > maxZ then maxZ = s.maxZ end
+  end
+  -- Removed bricks dirty their neighbors too
+  for key, old in pairs(prev) do
+    if not bricks[key] then changed[#changed + 1] = old end
+  end
+
+  -- 3. Dirty = changed bricks + face neighbors of changed/removed bricks
+  local dirty = {}
+  for _, c in ipairs(changed) do
+    if bricks[c.key] == c then dirty[c.key] = c end
+    for _, f in ipairs(FACE_OFFSETS) do
+      local nk = brickKey(c.bx + f.dx, c.by + f.dy, c.bz + f.dz)
+      local nb = bricks[nk]
+      if nb then dirty[nk] = nb end
+    end
+  end
+  -- Adopted bricks still belong to older grids (and their models' cached
+  -- shells), so a dirty one is copied before its surface is rewritten
+  local rebuilt = 0
+  for key, b in pairs(dirty) do
+    local at = adopted[key]
+    if at then
+      local copy = {}
+      for k, val in pairs(b) do copy[k] = val end
+      b = copy
+      bricks[key] = b
+      list[at] = b
+    end
+    rebuildSurface(b, bricks)
+    rebuilt = rebuilt + 1
+  end
+  _stats.bricksRebuilt = _stats.bricksRebuilt + rebuilt
+  _stats.bricksReused = _stats.bricksReused + (#list - rebuilt)
+  local shellCount = 0
+  for _, b in ipairs(list) do shellCount = shellCount + #b.surface end
+
+  local grid = {
+    bricks = bricks,
+    list = list,
+    voxelCount = n,
+    shellCount = shellCount,
+    fingerprint = fingerprint,
+    translucent = translucent,
+    rebuilt = rebuilt,
+    bounds = (n > 0) and {
+      minX = minX, maxX = maxX, minY = minY, maxY = maxY, minZ = minZ, maxZ = maxZ
+    } or { minX = 0, maxX = 0, minY = 0, maxY = 0, minZ = 0, maxZ = 0 }
+  }
+  _byModel[model] = grid
+  _last = grid
+  return grid
+end
+
+--------------------------------------------------------------------------------
+-- Shell (surface voxels only)
+--------------------------------------------------------------------------------
+-- Returns the shell as a voxel_buffer with extra fields
+-- { mask, count, fingerprint, translucent, bounds }; mask[i] is voxel i's
+-- hidden-face mask. Built from brick surfaces, so edits only pay for the
+-- bricks they dirtied; the concatenation itself is O(shell).
+function brickCache.getShell(model)
+  local grid = brickCache.update(model)
+  if not grid then return nil end
+  if grid.shell then return grid.shell end
+  local shell = getVoxelBuffer().new()
+  local X, Y, Z, RGBA, mask = shell.x, shell.y, shell.z, shell.rgba, {}
+  local n = 0
+  for _, b in ipairs(grid.list) do
+    local surface, masks, occ = b.surface, b.surfaceMask, b.occ
+    for k = 1, #surface do
+      local c = surface[k]
+      n = n + 1
+      X[n], Y[n], Z[n] = cellXYZ(b, c)
+      RGBA[n] = occ[c]
+      mask[n] = masks[k]
+    end
+  end
+  -- Extreme voxels always have an exposed face: shell bounds = model bounds
+  local bounds = grid.bounds
+  shell.n = n
+  if n > 0 then
+    shell.minX, shell.maxX = bounds.minX, bounds.maxX
+    shell.minY, shell.maxY = bounds.minY, bounds.maxY
+    shell.minZ, shell.maxZ = bounds.minZ, bounds.maxZ
+  end
+  shell.mask = mask
+  shell.count = n
+  shell.fingerprint = grid.fingerprint
+  shell.translucent = grid.translucent
+  shell.bounds = bounds
+  grid.shell = shell
+  return shell
+end
+
+--------------------------------------------------------------------------------
+-- Level of detail
+--------------------------------------------------------------------------------
+-- Coarse stand-in for interactive frames: one voxel per 2^level cell with
+-- coordinates divided down (render it at scale * 2^level). The first voxel of
+-- a cell supplies its color. Cached per model fingerprint; LOD grids never
+-- become the diff base for the full-resolution model.
+local _lods = {}
+
+function brickCache.getLod(model, level)
+  if not model or not level or level < 1 then return model end
+  local grid = brickCache.update(model)
+  if not grid then return model end
+  local hit = _lods[level]
+  if hit and hit.fingerprint == grid.fingerprint and hit.count == grid.voxelCount then
+    return hit.model
+  end
+  local vb = getVoxelBuffer()
+  local src = vb.of(model)
+  local X, Y, Z, RGBA = src.x, src.y, src.z, src.rgba
+  local f = 1 << level
+  local seen, out = {}, vb.new()
+  for i = 1, src.n do
+    local x = floor(X[i]) // f
+    local y = floor(Y[i]) // f
+    local z = floor(Z[i]) // f
+    local key = (x + 32768) + (y + 32768) * 65536 + (z + 32768) * 4294967296
+    if not seen[key] then
+      seen[key] = true
+      vb.push(out, x, y, z, RGBA[i])
+    end
+  end
+  local lod = vb.model(out)
+  local base = _last
+  brickCache.update(lod).lod = level
+  _last = base
+  _lods[level] = { fingerprint = grid.fingerprint, count = grid.voxelCount, model = lod }
+  return lod
+end
+
+-- Drop the cached grid for a model mutated in place (or everything)
+function brickCache.invalidate(model)
+  if model then
+    _byModel[model] = nil
+  else
+    _byModel = setmetatable({}, { __mode = "k" })
+    _last = nil
+    _lods = {}
+  end
+end
+
+function brickCache.getStats()
+  return {
+    updates = _stats.updates,
+    identityHits = _stats.identityHits,
+    bricksRebuilt = _stats.bricksRebuilt,
+    bricksReused = _stats.bricksReused,
+    bricks = _last and #_last.list or 0,
+    shellVoxels = _last and _last.shell and _last.shell.count or nil
+  }
+end
+
+--------------------------------------------------------------------------------
+-- Viewport culling
+--------------------------------------------------------------------------------
+-- view = {
+--   middlePoint, xRotation, yRotation, zRotation, voxelSize,
+--   centerX, centerY,                -- screen position of middlePoint
+--   camera = { focalLength, posZ }   -- nil for orthographic
+--   minX, minY, maxX, maxY           -- viewport rectangle (target pixels)
+-- }
+-- Projects each brick's AABB (same XYZ rotation as rotation.transformVoxel) and
+-- keeps bricks whose screen rectangle overlaps the viewport.
+-- Returns visible brick array, culled brick count.
+function brickCache.cullBricks(grid, view, out)
+  out = out or {}
+  local count = 0
+  local culled = 0
+  local mp = view.middlePoint
+  local xRad = math.rad(view.xRotation or 0)
+  local yRad = math.rad(view.yRotation or 0)
+  local zRad = math.rad(view.zRotation or 0)
+  local cx, sx = math.cos(xRad), math.sin(xRad)
+  local cy, sy = math.cos(yRad), math.sin(yRad)
+  local cz, sz = math.cos(zRad), math.sin(zRad)
+  local size = view.voxelSize
+  local cam = view.camera
+  local focal = cam and cam.focalLength
+  local posZ = cam and cam.posZ
+  local vminX, vminY = view.minX or 0, view.minY or 0
+  local vmaxX, vmaxY = view.maxX, view.maxY
+
+  for _, b in ipairs(grid.list) do
+    -- Voxels are centered on their coordinates; pad by one unit for safety
+    local x0, x1 = b.minX - 1 - mp.x, b.maxX + 1 - mp.x
+    local y0, y1 = b.minY - 1 - mp.y, b.maxY + 1 - mp.y
+    local z0, z1 = b.minZ - 1 - mp.z, b.maxZ + 1 - mp.z
+    local sMinX, sMinY, sMaxX, sMaxY = math.huge, math.huge, -math.huge, -math.huge
+    local behind = false
+    for corner = 0, 7 do
+      local x = (corner & 1 == 0) and x0 or x1
+      local y = (corner & 2 == 0) and y0 or y1
+      local z = (corner & 4 == 0) and z0 or z1
+      local y2 = y * cx - z * sx
+      local z2 = y * sx + z * cx
+      local x2 = x * cy + z2 * sy
+      local z3 = -x * sy + z2 * cy
+      local x3 = x2 * cz - y2 * sz
+      local y3 = x2 * sz + y2 * cz
+      local px, py
+      if focal then
+        local depth = posZ - (z3 + mp.z)
+        if depth < 0.001 then behind = true break end
+        local s = focal / depth
+        px = view.centerX + x3 * size * s
+        py = view.centerY + y3 * size * s
+      else
+        px = view.centerX + x3 * size
+        py = view.centerY + y3 * size
+      end
+      if px < sMinX then sMinX = px end
+      if px > sMaxX then sMaxX = px end
+      if py < sMinY then sMinY = py end
+      if py > sMaxY then sMaxY = py end
+    end
+    if behind or (sMaxX >= vminX and sMinX <= vmaxX and sMaxY >= vminY and sMinY <= vmaxY) then
+      count = count + 1
+      out[count] = b
+    else
+      culled = culled + 1
+    end
+  end
+  for i = count + 1, #out do out[i] = nil end
+  return out, culled
+end
+
+return brickCache
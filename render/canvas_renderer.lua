@@ -25,6 +25,64 @@ local function getFxStack()
   return AseVoxel.render.fx_stack
 end
 
+local function getDepthSort()
+  return AseVoxel.render.depth_sort
+end
+
+local function getBrickCache()
+  return AseVoxel.render.brick_cache
+end
+
+local function getVoxelBuffer()
+  return AseVoxel.render.voxel_buffer
+end
+
+-- Shell voxels (at least one exposed face) as a voxel buffer with hidden-face
+-- masks (shell.mask); falls back to the full model's buffer with no adjacency
+-- info when the brick cache is unavailable. Second return value identifies
+-- the face generation order (content fingerprint), so regenerated but
+-- identical models keep their draw order.
+local function getShellVoxels(voxelModel)
+  local brickCache = getBrickCache()
+  local shell = brickCache and brickCache.getShell(voxelModel)
+  if shell then return shell, shell.fingerprint end
+  return getVoxelBuffer().of(voxelModel), voxelModel
+end
+
+-- Voxel i of a shell as one reused {x,y,z,color} table (faces keep only the
+-- shared color) + its hidden-face table
+local _shellVoxel = { x = 0, y = 0, z = 0 }
+local function shellVoxel(shell, i)
+  local v = _shellVoxel
+  v.x, v.y, v.z = shell.x[i], shell.y[i], shell.z[i]
+  v.color = getVoxelBuffer().color(shell.rgba[i])
+  return v, shell.mask and getBrickCache().hiddenFaces(shell.mask[i])
+end
+
+local function modelBounds(voxelModel)
+  local vb = getVoxelBuffer()
+  local b = vb.bounds(vb.of(voxelModel))
+  return b.minX, b.maxX, b.minY, b.maxY, b.minZ, b.maxZ
+end
+
+-- Coherent draw-order state carried between frames (see depth_sort.lua)
+local _drawOrder = nil
+
+-- Back to front in linear time, repairing last frame's order when only the
+-- rotation moved slightly; plain comparison sort without depth_sort
+local function sortFaces(faces, shellKey, rotation, orthogonal)
+  local depthSort = getDepthSort()
+  if depthSort then
+    _drawOrder = _drawOrder or depthSort.newCoherent()
+    depthSort.sortListCoherent(_drawOrder, faces, shellKey, {
+      xRotation = rotation.x, yRotation = rotation.y, zRotation = rotation.z,
+      orthogonal = orthogonal
+    })
+  else
+    table.sort(faces, function(a, b) return a.depth > b.depth end)
+  end
+end
+
 -- Helper: Draw a single quad face using GraphicsContext paths
 local function drawQuadPath(ctx, p1, p2, p3, p4, color)
   -- Ensure color is a proper Color object
@@ -104,18 +162,7 @@ local function calculateMiddlePoint(voxelModel)
     return {x = 0, y = 0, z = 0}
   end
   
-  local minX, maxX = math.huge, -math.huge
-  local minY, maxY = math.huge, -math.huge
-  local minZ, maxZ = math.huge, -math.huge
-  
-  for _, voxel in ipairs(voxelModel) do
-    if voxel.x < minX then minX = voxel.x end
-    if voxel.x > maxX then maxX = voxel.x end
-    if voxel.y < minY then minY = voxel.y end
-    if voxel.y > maxY then maxY = voxel.y end
-    if voxel.z < minZ then minZ = voxel.z end
-    if voxel.z > maxZ then maxZ = voxel.z end
-  end
+  local minX, maxX, minY, maxY, minZ, maxZ = modelBounds(voxelModel)
   
   return {
     x = (minX + maxX) / 2,
@@ -175,7 +222,7 @@ local function transformPoint(x, y, z, middlePoint, rotation, scale, width, heig
 end
 
 -- Generate face quads for a voxel
-local function generateVoxelFaces(voxel, middlePoint, rotation, voxelSize, width, height, orthogonal, fovDegrees, offsetX, offsetY, shadingMode, fxStack, lighting, params)
+local function generateVoxelFaces(voxel, middlePoint, rotation, voxelSize, width, height, orthogonal, fovDegrees, offsetX, offsetY, shadingMode, fxStack, lighting, params, hiddenFaces)
   local faces = {}
   
   -- Define cube faces (6 faces, 4 vertices each)
@@ -222,44 +269,46 @@ local function generateVoxelFaces(voxel, middlePoint, rotation, voxelSize, width
   local shading = getShading()
   
   for _, faceDef in ipairs(faceDefinitions) do
-    -- Transform vertices to screen space
-    local screenVerts = {}
-    local avgDepth = 0
-    for _, vert in ipairs(faceDef.vertices) do
-      local transformed = transformPoint(
-        vert.x, vert.y, vert.z,
-        middlePoint, rotation, voxelSize, width, height,
-        orthogonal, fovDegrees, offsetX, offsetY
-      )
-      table.insert(screenVerts, transformed)
-      avgDepth = avgDepth + transformed.z
-    end
-    avgDepth = avgDepth / #screenVerts
+    if not (hiddenFaces and hiddenFaces[faceDef.name]) then
+      -- Transform vertices to screen space
+      local screenVerts = {}
+      local avgDepth = 0
+      for _, vert in ipairs(faceDef.vertices) do
+        local transformed = transformPoint(
+          vert.x, vert.y, vert.z,
+          middlePoint, rotation, voxelSize, width, height,
+          orthogonal, fovDegrees, offsetX, offsetY
+        )
+        table.insert(screenVerts, transformed)
+        avgDepth = avgDepth + transformed.z
+      end
+      avgDepth = avgDepth / #screenVerts
     
-    -- Calculate face color based on shading mode
-    local faceColor = voxel.color
-    if shading and shadingMode then
-      -- Build params for shadeFaceColor (unified shading function)
-      local shadingParams = {
-        shadingMode = shadingMode,
-        basicShadeIntensity = params.basicShadeIntensity or 50,
-        basicLightIntensity = params.basicLightIntensity or 50,
-        fxStack = fxStack,
-        lighting = lighting,
-        xRotation = rotation.x,
-        yRotation = rotation.y,
-        zRotation = rotation.z,
-      }
+      -- Calculate face color based on shading mode
+      local faceColor = voxel.color
+      if shading and shadingMode then
+        -- Build params for shadeFaceColor (unified shading function)
+        local shadingParams = {
+          shadingMode = shadingMode,
+          basicShadeIntensity = params.basicShadeIntensity or 50,
+          basicLightIntensity = params.basicLightIntensity or 50,
+          fxStack = fxStack,
+          lighting = lighting,
+          xRotation = rotation.x,
+          yRotation = rotation.y,
+          zRotation = rotation.z,
+        }
       
-      faceColor = shading.shadeFaceColor(faceDef.name, voxel.color, shadingParams)
-    end
+        faceColor = shading.shadeFaceColor(faceDef.name, voxel.color, shadingParams)
+      end
     
-    table.insert(faces, {
-      verts = screenVerts,
-      color = faceColor,
-      depth = avgDepth,
-      name = faceDef.name
-    })
+      table.insert(faces, {
+        verts = screenVerts,
+        color = faceColor,
+        depth = avgDepth,
+        name = faceDef.name
+      })
+    end
   end
   
   return faces
@@ -305,17 +354,7 @@ function canvasRenderer.renderVoxelModel(ctx, voxelModel, params)
   local middlePoint = calculateMiddlePoint(voxelModel)
   
   -- Calculate model dimensions
-  local minX, maxX = math.huge, -math.huge
-  local minY, maxY = math.huge, -math.huge
-  local minZ, maxZ = math.huge, -math.huge
-  for _, v in ipairs(voxelModel) do
-    if v.x < minX then minX = v.x end
-    if v.x > maxX then maxX = v.x end
-    if v.y < minY then minY = v.y end
-    if v.y > maxY then maxY = v.y end
-    if v.z < minZ then minZ = v.z end
-    if v.z > maxZ then maxZ = v.z end
-  end
+  local minX, maxX, minY, maxY, minZ, maxZ = modelBounds(voxelModel)
   local modelWidth = maxX - minX + 1
   local modelHeight = maxY - minY + 1
   local modelDepth = maxZ - minZ + 1
@@ -332,13 +371,15 @@ function canvasRenderer.renderVoxelModel(ctx, voxelModel, params)
   print("[canvas_renderer] Model dims: " .. modelWidth .. "x" .. modelHeight .. "x" .. modelDepth .. 
         ", voxelSize: " .. voxelSize .. ", scale: " .. scale)
   
-  -- Generate all face quads
+  -- Generate face quads for shell voxels only (interior voxels have no exposed faces)
   local allFaces = {}
-  for _, voxel in ipairs(voxelModel) do
+  local shell, shellKey = getShellVoxels(voxelModel)
+  for i = 1, shell.n do
+    local voxel, hiddenFaces = shellVoxel(shell, i)
     local voxelFaces = generateVoxelFaces(
       voxel, middlePoint, rotation, voxelSize, width, height,
       orthogonal, fovDegrees, offsetX, offsetY,
-      shadingMode, fxStack, lighting, params
+      shadingMode, fxStack, lighting, params, hiddenFaces
     )
     for _, face in ipairs(voxelFaces) do
       table.insert(allFaces, face)
@@ -346,9 +387,7 @@ function canvasRenderer.renderVoxelModel(ctx, voxelModel, params)
   end
   
   -- Sort faces by depth (painter's algorithm: back to front)
-  table.sort(allFaces, function(a, b)
-    return a.depth > b.depth
-  end)
+  sortFaces(allFaces, shellKey, rotation, orthogonal)
   
   print("[canvas_renderer] Generated " .. #allFaces .. " faces total")
   if #allFaces > 0 then
@@ -423,17 +462,7 @@ function canvasRenderer.prepareFaces(voxelModel, params)
   local middlePoint = calculateMiddlePoint(voxelModel)
   
   -- Calculate model dimensions
-  local minX, maxX = math.huge, -math.huge
-  local minY, maxY = math.huge, -math.huge
-  local minZ, maxZ = math.huge, -math.huge
-  for _, v in ipairs(voxelModel) do
-    if v.x < minX then minX = v.x end
-    if v.x > maxX then maxX = v.x end
-    if v.y < minY then minY = v.y end
-    if v.y > maxY then maxY = v.y end
-    if v.z < minZ then minZ = v.z end
-    if v.z > maxZ then maxZ = v.z end
-  end
+  local minX, maxX, minY, maxY, minZ, maxZ = modelBounds(voxelModel)
   local modelWidth = maxX - minX + 1
   local modelHeight = maxY - minY + 1
   local modelDepth = maxZ - minZ + 1
@@ -446,13 +475,15 @@ function canvasRenderer.prepareFaces(voxelModel, params)
     voxelSize = maxAllowed / maxDimension
   end
   
-  -- Generate all face quads
+  -- Generate face quads for shell voxels only (interior voxels have no exposed faces)
   local allFaces = {}
-  for _, voxel in ipairs(voxelModel) do
+  local shell, shellKey = getShellVoxels(voxelModel)
+  for i = 1, shell.n do
+    local voxel, hiddenFaces = shellVoxel(shell, i)
     local voxelFaces = generateVoxelFaces(
       voxel, middlePoint, rotation, voxelSize, width, height,
       orthogonal, fovDegrees, offsetX, offsetY,
-      shadingMode, fxStack, lighting, params
+      shadingMode, fxStack, lighting, params, hiddenFaces
     )
     for _, face in ipairs(voxelFaces) do
       table.insert(allFaces, face)
@@ -460,9 +491,7 @@ function canvasRenderer.prepareFaces(voxelModel, params)
   end
   
   -- Sort faces by depth (painter's algorithm: back to front)
-  table.sort(allFaces, function(a, b)
-    return a.depth > b.depth
-  end)
+  sortFaces(allFaces, shellKey, rotation, orthogonal)
   
   local prepareTimeMs = (os.clock() - startTime) * 1000
   
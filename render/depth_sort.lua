@@ -0,0 +1,254 @@
+-- depth_sort.lua
+-- Linear-time painter's ordering for draw lists.
+-- Depths are quantized to 32-bit keys and ordered back-to-front through the
+-- native radix sort when available, otherwise a Lua counting sort over depth
+-- slices. A short insertion pass then restores exact order inside slices.
+
+local depthSort = {}
+
+local function getNativeBridge()
+  return AseVoxel.render.native_bridge
+end
+
+local KEY_MAX = 0xFFFFFFFF
+depthSort.MIN_BUCKETS = 16
+depthSort.MAX_BUCKETS = 65536
+-- Insertion repair gives up (comparison sort) past this many shifts per item
+depthSort.REPAIR_BUDGET = 8
+
+-- Scratch arrays reused across calls (no per-frame allocation once warm)
+local _keys, _counts, _depths, _items = {}, {}, {}, {}
+
+local _stats = { calls = 0, native = 0, lua = 0, coherent = 0, fallbacks = 0 }
+
+local function trim(t, n)
+  for i = #t, n + 1, -1 do t[i] = nil end
+end
+
+-- Insertion pass over a nearly sorted permutation (descending depth, stable).
+-- Returns false when it would exceed the shift budget.
+local function repair(perm, depths, n, perItem)
+  local budget = n * (perItem or depthSort.REPAIR_BUDGET)
+  for i = 2, n do
+    local v = perm[i]
+    local d = depths[v]
+    local j = i - 1
+    while j >= 1 and depths[perm[j]] < d do
+      perm[j + 1] = perm[j]
+      j = j - 1
+      budget = budget - 1
+    end
+    perm[j + 1] = v
+    if budget < 0 then return false end
+  end
+  return true
+end
+
+--------------------------------------------------------------------------------
+-- depthSort.order(depths, n, perm)
+-- depths: array of depth values (larger = farther from camera)
+-- perm:   optional output array, reused by the caller
+-- Returns perm such that depths[perm[1]] is the farthest, plus the backend used.
+--------------------------------------------------------------------------------
+function depthSort.order(depths, n, perm)
+  perm = perm or {}
+  n = n or #depths
+  _stats.calls = _stats.calls + 1
+
+  local dMin, dMax = math.huge, -math.huge
+  for i = 1, n do
+    local d = depths[i]
+    if d < dMin then dMin = d end
+    if d > dMax then dMax = d end
+  end
+  local range = dMax - dMin
+  if n < 2 or not (range > 0) or range == math.huge then
+    for i = 1, n do perm[i] = i end
+    trim(perm, n)
+    return perm, "none"
+  end
+
+  local backend
+  local keys = _keys
+
+  -- Native radix sort over quantized keys (ascending key = descending depth)
+  local nb = getNativeBridge()
+  if nb and nb.radixSortKeys and nb.isAvailable() then
+    local inv = KEY_MAX / range
+    for i = 1, n do keys[i] = math.floor((dMax - depths[i]) * inv) end
+    trim(keys, n)
+    local p = nb.radixSortKeys(keys, n)
+    if p and #p == n then
+      for i = 1, n do perm[i] = p[i] end
+      backend = "native"
+      _stats.native = _stats.native + 1
+    end
+  end
+
+  -- Lua fallback: counting sort over integer depth slices (stable)
+  if not backend then
+    local buckets = math.max(depthSort.MIN_BUCKETS, math.min(depthSort.MAX_BUCKETS, n))
+    local scale = (buckets - 1) / range
+    local counts = _counts
+    for b = 1, buckets do counts[b] = 0 end
+    for i = 1, n do
+      local b = math.floor((dMax - depths[i]) * scale) + 1
+      keys[i] = b
+      counts[b] = counts[b] + 1
+    end
+    local pos = 0
+    for b = 1, buckets do
+      local c = counts[b]
+      counts[b] = pos
+      pos = pos + c
+    end
+    for i = 1, n do
+      local b = keys[i]
+      local p = counts[b] + 1
+      counts[b] = p
+      perm[p] = i
+    end
+    backend = "lua"
+    _stats.lua = _stats.lua + 1
+  end
+  trim(perm, n)
+
+  if not repair(perm, depths, n) then
+    -- Pathological distribution (one outlier squeezing everything into a
+    -- single slice): finish with a comparison sort on the permutation.
+    table.sort(perm, function(a, b)
+      local da, db = depths[a], depths[b]
+      if da ~= db then return da > db end
+      return a < b
+    end)
+    _stats.fallbacks = _stats.fallbacks + 1
+  end
+  return perm, backend
+end
+
+--------------------------------------------------------------------------------
+-- depthSort.sortList(list, field)
+-- In-place back-to-front reorder of an array of tables by item[field]
+-- (default "depth"). Drop-in for table.sort(list, a.depth > b.depth).
+--------------------------------------------------------------------------------
+local _perm = {}
+function depthSort.sortList(list, field)
+  field = field or "depth"
+  local n = #list
+  if n < 2 then return list end
+  local depths, items = _depths, _items
+  for i = 1, n do
+    local it = list[i]
+    items[i] = it
+    depths[i] = it[field]
+  end
+  local perm = depthSort.order(depths, n, _perm)
+  for i = 1, n do list[i] = items[perm[i]] end
+  -- Release item references held by the scratch array
+  for i = 1, n do items[i] = nil end
+  return list
+end
+
+--------------------------------------------------------------------------------
+-- Temporal coherence
+-- During a drag consecutive frames differ by a degree or two, so last frame's
+-- permutation is nearly sorted for this frame. A coherent state remembers it
+-- (with the source it indexes and the rotation it was computed at) and
+-- repairs it with the insertion pass; a rotation jump, a different source or
+-- a blown repair budget falls back to the full order().
+-- The counting sort is already linear, so repair only pays off while items
+-- move a couple of slots per frame: the budget is tight, and after a miss the
+-- state backs off (doubling, capped) before trying again.
+--------------------------------------------------------------------------------
+depthSort.COHERENT_MAX_DEG = 10
+depthSort.COHERENT_BUDGET = 2
+depthSort.COHERENT_MAX_BACKOFF = 16
+
+function depthSort.newCoherent()
+  return {
+    perm = {}, n = 0, source = nil,
+    xRot = 0, yRot = 0, zRot = 0, orthogonal = nil,
+    backoff = 0, skip = 0
+  }
+end
+
+local function angleDelta(a, b)
+  local d = math.abs((a or 0) - (b or 0)) % 360
+  if d > 180 then d = 360 - d end
+  return d
+end
+
+-- state:  from newCoherent()
+-- depths: depth per item, generated in the same order for the same source
+-- source: identity/fingerprint of what produced the items (mesh, shell, ...)
+-- view:   { xRotation, yRotation, zRotation, orthogonal }
+-- Returns state.perm (back-to-front item indices; owned by the state, so
+-- callers that reorder it further work on a copy) and the backend used.
+function depthSort.orderCoherent(state, depths, n, source, view)
+  local perm = state.perm
+  if n < 2 then
+    for i = 1, n do perm[i] = i end
+    trim(perm, n)
+    return perm, "none"
+  end
+  local backend
+  local maxDeg = depthSort.COHERENT_MAX_DEG
+  if state.source == source and state.n == n
+     and state.orthogonal == (view.orthogonal and true or false)
+     and angleDelta(state.xRot, view.xRotation) <= maxDeg
+     and angleDelta(state.yRot, view.yRotation) <= maxDeg
+     and angleDelta(state.zRot, view.zRotation) <= maxDeg then
+    if state.skip > 0 then
+      state.skip = state.skip - 1
+    elseif repair(perm, depths, n, depthSort.COHERENT_BUDGET) then
+      backend = "coherent"
+      state.backoff = 0
+      _stats.coherent = _stats.coherent + 1
+    else
+      state.backoff = math.min(depthSort.COHERENT_MAX_BACKOFF, math.max(1, state.backoff * 2))
+      state.skip = state.backoff
+    end
+  end
+  if not backend then
+    local _
+    _, backend = depthSort.order(depths, n, perm)
+  end
+
+  state.source = source
+  state.n = n
+  state.xRot = view.xRotation or 0
+  state.yRot = view.yRotation or 0
+  state.zRot = view.zRotation or 0
+  state.orthogonal = view.orthogonal and true or false
+  return perm, backend
+end
+
+-- list:   array of tables, generated in the same order for the same source
+-- (other arguments as orderCoherent)
+function depthSort.sortListCoherent(state, list, source, view, field)
+  field = field or "depth"
+  local n = #list
+  if n < 2 then return list, "none" end
+  local depths, items = _depths, _items
+  for i = 1, n do
+    local it = list[i]
+    items[i] = it
+    depths[i] = it[field]
+  end
+  local perm, backend = depthSort.orderCoherent(state, depths, n, source, view)
+  for i = 1, n do list[i] = items[perm[i]] end
+  for i = 1, n do items[i] = nil end
+  return list, backend
+end
+
+function depthSort.getStats()
+  return {
+    calls = _stats.calls,
+    native = _stats.native,
+    lua = _stats.lua,
+    coherent = _stats.coherent,
+    fallbacks = _stats.fallbacks
+  }
+end
+
+return depthSort
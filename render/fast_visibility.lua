@@ -17,11 +17,28 @@ local FACE_NORMALS = {
   bottom = { x=0,  y=-1, z=0  }
 }
 
+-- Renderer face mask bits (preview_renderer FACE_DEFS)
+local FACE_BIT = { front = 1, back = 2, right = 4, left = 8, top = 16, bottom = 32 }
+
 -- Cache for rotated normals (recalculated only when rotation changes)
 local cachedRotation = { xRot = nil, yRot = nil, zRot = nil }
 local cachedNormals = nil
 local cachedVisibleFaces = nil
 local cachedFaceOrder = nil -- depth order: back to front
+local cachedMask = nil
+
+-- Lua path scratch, refilled in place on every rotation change (a drag
+-- changes rotation every frame)
+local _normals, _visible, _order, _depths = {}, {}, {}, {}
+local function _nearerLater(a, b) return _depths[a] < _depths[b] end
+
+local function maskOf(visibleFaces)
+  local m = 0
+  for name, bit in pairs(FACE_BIT) do
+    if visibleFaces[name] then m = m | bit end
+  end
+  return m
+end
 
 --------------------------------------------------------------------------------
 -- Rotate a normal vector by Euler angles (X, Y, Z order)
@@ -65,6 +82,7 @@ function fastVisibility.updateRotation(xRot, yRot, zRot, orthogonal)
       if ok and result then
         cachedVisibleFaces = result.visibleFaces
         cachedFaceOrder = result.faceOrder
+        cachedMask = maskOf(cachedVisibleFaces)
         
         -- Also get rotated normals for lighting
         if mod.precompute_rotated_normals then
@@ -98,14 +116,20 @@ function fastVisibility.updateRotation(xRot, yRot, zRot, orthogonal)
   end
   
   -- Rotate all 6 face normals and check visibility
-  cachedNormals = {}
-  cachedVisibleFaces = {}
-  local visibleList = {}
-  local faceDepths = {}
+  cachedNormals = _normals
+  cachedVisibleFaces = _visible
+  local visibleList = _order
+  local faceDepths = _depths
+  local count, mask = 0, 0
   
   for faceName, n in pairs(FACE_NORMALS) do
     local nx, ny, nz = rotateNormal(n.x, n.y, n.z, cx, sx, cy, sy, cz, sz)
-    cachedNormals[faceName] = { x = nx, y = ny, z = nz }
+    local rn = cachedNormals[faceName]
+    if not rn then
+      rn = {}
+      cachedNormals[faceName] = rn
+    end
+    rn.x, rn.y, rn.z = nx, ny, nz
     
     -- Dot product with view direction
     local dot = nx * viewX + ny * viewY + nz * viewZ
@@ -115,18 +139,20 @@ function fastVisibility.updateRotation(xRot, yRot, zRot, orthogonal)
     cachedVisibleFaces[faceName] = isVisible
     
     if isVisible then
-      table.insert(visibleList, faceName)
+      count = count + 1
+      visibleList[count] = faceName
+      mask = mask | FACE_BIT[faceName]
       -- Depth for sorting: larger dot = more facing camera = should draw later
       faceDepths[faceName] = dot
     end
   end
+  for i = count + 1, #visibleList do visibleList[i] = nil end
   
   -- Sort visible faces by depth (back to front for painter's algorithm)
-  table.sort(visibleList, function(a, b)
-    return faceDepths[a] < faceDepths[b]
-  end)
+  table.sort(visibleList, _nearerLater)
   
   cachedFaceOrder = visibleList
+  cachedMask = mask
 end
 
 --------------------------------------------------------------------------------
@@ -155,6 +181,14 @@ function fastVisibility.getVisibleFaceList()
   return cachedFaceOrder or {}
 end
 
+--------------------------------------------------------------------------------
+-- Visible faces as a face bit mask (front=1 back=2 right=4 left=8 top=16
+-- bottom=32), or nil before the first updateRotation
+--------------------------------------------------------------------------------
+function fastVisibility.getVisibleMask()
+  return cachedMask
+end
+
 --------------------------------------------------------------------------------
 -- Get rotated normals for lighting calculations
 --------------------------------------------------------------------------------
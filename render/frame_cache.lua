@@ -0,0 +1,185 @@
+-- frame_cache.lua
+-- LRU cache of finished preview images, bounded by an approximate byte budget
+-- (4 bytes per RGBA pixel). Keys combine the model fingerprint (brick_cache),
+-- the rotation and a canonical serialization of the remaining render params,
+-- so equal views hit regardless of table identity or key order. Interactive
+-- preview params (params.cacheQuantized) key the rotation quantized to
+-- ROTATION_QUANTUM degrees, so a nearby frame is close enough; every other
+-- caller (batch, exports) keys the exact angle.
+-- Hits return the cached Image itself: callers must not modify it.
+
+local frameCache = {}
+
+frameCache.MAX_BYTES = 64 * 1024 * 1024
+frameCache.ROTATION_QUANTUM = 0.5
+
+-- Params that never change the image (or are keyed separately)
+local SKIP = {
+  metrics = true, enableProfiling = true, rotationMatrix = true, noFrameCache = true,
+  cacheQuantized = true,
+  x = true, y = true, z = true,
+  xRotation = true, yRotation = true, zRotation = true,
+  eulerX = true, eulerY = true, eulerZ = true,
+  absoluteX = true, absoluteY = true, absoluteZ = true,
+  relativeX = true, relativeY = true, relativeZ = true
+}
+
+-- Doubly linked recency list: head = most recent
+local _map = {}
+local _head, _tail = nil, nil
+local _count = 0
+local _bytes = 0
+local _stats = { hits = 0, misses = 0, puts = 0, evictions = 0 }
+
+local function unlink(e)
+  if e.prev then e.prev.next = e.next else _head = e.next end
+  if e.next then e.next.prev = e.prev else _tail = e.prev end
+  e.prev, e.next = nil, nil
+end
+
+local function pushFront(e)
+  e.next = _head
+  e.prev = nil
+  if _head then _head.prev = e end
+  _head = e
+  if not _tail then _tail = e end
+end
+
+--------------------------------------------------------------------------------
+-- Keys
+--------------------------------------------------------------------------------
+-- omit: one more key to leave out of this table (not of nested ones)
+local function canon(v, out, omit)
+  local t = type(v)
+  if t == "table" then
+    local keys = {}
+    for k in pairs(v) do
+      if type(k) ~= "string" or (k:sub(1, 1) ~= "_" and not SKIP[k] and k ~= omit) then
+        keys[#keys + 1] = k
+      end
+    end
+    table.sort(keys, function(a, b) return tostring(a) < tostring(b) end)
+    out[#out + 1] = "{"
+    for _, k in ipairs(keys) do
+      out[#out + 1] = tostring(k)
+      out[#out + 1] = "="
+      canon(v[k], out)
+      out[#out + 1] = ","
+    end
+    out[#out + 1] = "}"
+  elseif t == "userdata" then
+    -- Color objects: compare by channels, not identity
+    local ok, s = pcall(function()
+      return string.format("c%d,%d,%d,%d", v.red, v.green, v.blue, v.alpha)
+    end)
+    out[#out + 1] = ok and s or tostring(v)
+  elseif t == "number" then
+    out[#out + 1] = string.format("%.6g", v)
+  else
+    out[#out + 1] = tostring(v)
+  end
+end
+
+local function quantize(deg)
+  local q = frameCache.ROTATION_QUANTUM
+  local a = (deg or 0) % 360
+  return "q" .. (math.floor(a / q + 0.5) % math.floor(360 / q))
+end
+
+local function exact(deg)
+  return string.format("%.17g", (deg or 0) % 360)
+end
+
+-- fingerprint/count: from brick_cache; params: renderVoxelModel params
+function frameCache.makeKey(fingerprint, count, params)
+  local angle = params.cacheQuantized and quantize or exact
+  local out = {
+    tostring(fingerprint), ":", tostring(count), "|",
+    angle(params.x or params.xRotation), ",",
+    angle(params.y or params.yRotation), ",",
+    angle(params.z or params.zRotation), "|",
+    -- Backends take scale from scaleLevel when it is unset: key both alike
+    string.format("%.6g", params.scale or params.scaleLevel or 1), "|"
+  }
+  canon(params, out, "scale")
+  return table.concat(out)
+end
+
+--------------------------------------------------------------------------------
+-- Lookup / insert
+--------------------------------------------------------------------------------
+-- Returns the shared cached Image (read-only for the caller) or nil
+function frameCache.get(key)
+  local e = _map[key]
+  if not e then
+    _stats.misses = _stats.misses + 1
+    return nil
+  end
+  _stats.hits = _stats.hits + 1
+  unlink(e)
+  pushFront(e)
+  return e.image
+end
+
+-- Presence test without touching recency or counters
+function frameCache.peek(key)
+  return _map[key] ~= nil
+end
+
+local function evictOver(budget)
+  while _bytes > budget and _tail do
+    local old = _tail
+    unlink(old)
+    _map[old.key] = nil
+    _count = _count - 1
+    _bytes = _bytes - old.bytes
+    _stats.evictions = _stats.evictions + 1
+  end
+end
+
+function frameCache.put(key, image)
+  if not key or not image then return end
+  local bytes = image.width * image.height * 4
+  if bytes > frameCache.MAX_BYTES then return end
+  local e = _map[key]
+  if e then
+    _bytes = _bytes - e.bytes + bytes
+    e.image, e.bytes = image, bytes
+    unlink(e)
+    pushFront(e)
+  else
+    e = { key = key, image = image, bytes = bytes }
+    _map[key] = e
+    pushFront(e)
+    _count = _count + 1
+    _bytes = _bytes + bytes
+    _stats.puts = _stats.puts + 1
+  end
+  evictOver(frameCache.MAX_BYTES)
+end
+
+function frameCache.setBudget(bytes)
+  frameCache.MAX_BYTES = bytes
+  evictOver(bytes)
+end
+
+function frameCache.clear()
+  _map = {}
+  _head, _tail = nil, nil
+  _count = 0
+  _bytes = 0
+end
+
+function frameCache.getStats()
+  return {
+    entries = _count,
+    bytes = _bytes,
+    budget = frameCache.MAX_BYTES,
+    hits = _stats.hits,
+    misses = _stats.misses,
+    puts = _stats.puts,
+    evictions = _stats.evictions
+  }
+end
+
+return frameCache
@@ -29,35 +29,29 @@ local NEIGHBORS = {
   bottom = {dx= 0, dy=-1, dz= 0},
 }
 
-local function key(x,y,z)
-  return tostring(x) .. "," .. tostring(y) .. "," .. tostring(z)
-end
-
 -- Builds a triangle mesh:
 -- returns {
 --   vertices = { {x,y,z}, ... },
 --   triangles = { {i1,i2,i3, color={r,g,b,a}}, ... },
 --   bounds = { minX, maxX, minY, maxY, minZ, maxZ }
 -- }
+-- voxels: model table or VoxelBuffer. Triangle colors are the shared
+-- voxel_buffer color tables (one per distinct RGBA, read-only).
 function meshBuilder.buildMesh(voxels)
   local mesh = { vertices = {}, triangles = {}, bounds = nil }
-  if not voxels or #voxels == 0 then return mesh end
+  if not voxels then return mesh end
+  local vb = AseVoxel.render.voxel_buffer
+  local buf = vb.of(voxels)
+  if buf.n == 0 then return mesh end
+  local X, Y, Z, RGBA = buf.x, buf.y, buf.z, buf.rgba
+  local key = vb.key
 
   -- Build occupancy map
   local occ = {}
-  local minX, maxX = math.huge, -math.huge
-  local minY, maxY = math.huge, -math.huge
-  local minZ, maxZ = math.huge, -math.huge
-  for _, v in ipairs(voxels) do
-    occ[key(v.x, v.y, v.z)] = true
-    if v.x < minX then minX = v.x end
-    if v.x > maxX then maxX = v.x end
-    if v.y < minY then minY = v.y end
-    if v.y > maxY then maxY = v.y end
-    if v.z < minZ then minZ = v.z end
-    if v.z > maxZ then maxZ = v.z end
+  for i = 1, buf.n do
+    occ[key(X[i], Y[i], Z[i])] = true
   end
-  mesh.bounds = { minX=minX, maxX=maxX, minY=minY, maxY=maxY, minZ=minZ, maxZ=maxZ }
+  mesh.bounds = vb.bounds(buf)
 
   local verts = mesh.vertices
   local tris  = mesh.triangles
@@ -80,16 +74,16 @@ function meshBuilder.buildMesh(voxels)
     local b = baseIndex + q[2]
     local c = baseIndex + q[3]
     local d = baseIndex + q[4]
-    tris[#tris+1] = { a, b, c, color = { r=color.r or color.red or 255, g=color.g or color.green or 255, b=color.b or color.blue or 255, a=color.a or color.alpha or 255 } }
-    tris[#tris+1] = { a, c, d, color = { r=color.r or color.red or 255, g=color.g or color.green or 255, b=color.b or color.blue or 255, a=color.a or color.alpha or 255 } }
+    tris[#tris+1] = { a, b, c, color = color }
+    tris[#tris+1] = { a, c, d, color = color }
   end
 
-  for _, v in ipairs(voxels) do
+  for i = 1, buf.n do
     -- For each face, if neighbor exists, skip; otherwise emit face
+    local x, y, z = X[i], Y[i], Z[i]
     for fname, off in pairs(NEIGHBORS) do
-      local nx, ny, nz = v.x + off.dx, v.y + off.dy, v.z + off.dz
-      if not occ[key(nx, ny, nz)] then
-        emitFace(v.x, v.y, v.z, fname, v.color or {r=255,g=255,b=255,a=255})
+      if not occ[key(x + off.dx, y + off.dy, z + off.dz)] then
+        emitFace(x, y, z, fname, vb.color(RGBA[i]))
       end
     end
   end
@@ -4,6 +4,13 @@
 
 local meshPipeline = {}
 
+local function getDepthSort()
+  return AseVoxel.render.depth_sort
+end
+
+-- Coherent draw-order state carried between frames
+local _drawOrder = nil
+
 --------------------------------------------------------------------------------
 -- Constants
 --------------------------------------------------------------------------------
@@ -314,7 +321,16 @@ function meshPipeline.render(mesh, params)
     end
   end
   
-  table.sort(drawList, function(a,b) return a.depth > b.depth end)
+  local depthSort = getDepthSort()
+  if depthSort then
+    -- Reuse last frame's order while dragging (same mesh, small rotation step)
+    _drawOrder = _drawOrder or depthSort.newCoherent()
+    depthSort.sortListCoherent(_drawOrder, drawList, mesh, {
+      xRotation = xRot, yRotation = yRot, zRotation = zRot, orthogonal = orthogonal
+    })
+  else
+    table.sort(drawList, function(a,b) return a.depth > b.depth end)
+  end
   
   -- Rasterize triangles
   for _, it in ipairs(drawList) do
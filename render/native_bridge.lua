@@ -15,7 +15,13 @@ local nativeBridge = {
     render_stack_ok = true,
     render_stack_fail = true,
     render_dynamic_ok = true,
-    render_dynamic_fail = true
+    render_dynamic_fail = true,
+    radix_sort_ok = true,
+    radix_sort_fail = true,
+    submit_render_ok = true,
+    submit_render_fail = true,
+    render_batch_ok = true,
+    render_batch_fail = true
   }
 }
 
@@ -242,6 +248,17 @@ function nativeBridge.calculateFaceVisibility(voxel, cameraPos, orthogonal, rota
   return vis
 end
 
+-- render_basic / render_stack / render_dynamic (and each job/batch result)
+-- return { width, height, pixels [, metrics] }. Builds that time their own
+-- stages fill metrics with milliseconds from a monotonic clock:
+--   parse_ms, transform_ms, cull_ms, raster_ms (sort + raster), shade_ms,
+--   outline_ms, downsample_ms
+-- and counters: faces_drawn, pixels_written, overdraw (writes per covered
+-- pixel), alloc_count, alloc_bytes (heap allocations made by this frame).
+-- With params.perfCounters (bench/native_bench.lua --perf), Linux builds may
+-- add perf_event_open counts: perf = { <stage> = { cycles, instructions,
+-- l1d_misses, llc_misses, branch_misses } } and perf_threads = { same per
+-- worker thread }. Every field is optional; older builds return no metrics.
 function nativeBridge.renderBasic(voxels, params)
   local m = mod()
   if not (m and m.render_basic) then
@@ -314,6 +331,118 @@ function nativeBridge.renderDynamic(voxels, params)
   return res
 end
 
+-- Radix sort of 32-bit unsigned depth keys (1..n). Returns a 1-based
+-- permutation array ordering keys ascending (stable), or nil on failure.
+function nativeBridge.radixSortKeys(keys, n)
+  local m = mod()
+  if not (m and m.radix_sort_u32) then return nil, "native missing" end
+  local ok, perm = pcall(m.radix_sort_u32, keys, n or #keys)
+  if not ok or type(perm) ~= "table" then
+    if not nativeBridge._logOnce.radix_sort_fail then
+      nativeBridge._logOnce.radix_sort_fail = true
+      print("[asevoxel-native] radix_sort_u32 FAILED, falling back to Lua: " .. tostring(perm))
+    end
+    return nil, perm
+  end
+  if not nativeBridge._logOnce.radix_sort_ok then
+    nativeBridge._logOnce.radix_sort_ok = true
+    print("[asevoxel-native] radix_sort_u32 (native)")
+  end
+  return perm
+end
+
+-- Native heap accounting, when the build exports memory_stats():
+--   { bytes = { <category> = live bytes, ... }, peak_bytes, allocations, frees }
+-- Categories are whatever the build tracks (voxels, zbuffer, framebuffer,
+-- jobs, ...). nil when unavailable.
+function nativeBridge.getMemoryStats()
+  local m = mod()
+  if not (m and m.memory_stats) then return nil end
+  local ok, res = pcall(m.memory_stats)
+  if not ok or type(res) ~= "table" then return nil end
+  return res
+end
+
+-- True when the loaded module exposes the background job API
+function nativeBridge.supportsAsync()
+  local m = mod()
+  return (m and m.submit_render) and true or false
+end
+
+-- Background render on a native worker thread.
+-- kind: "basic" | "stack" | "dynamic" (same voxels/params as the blocking calls)
+-- Returns a job: job:poll() -> "running" | "done" | "cancelled" | "failed",
+-- job:cancel(), job:result() -> { width, height, pixels } once done.
+-- Returns nil when the module has no job API or submission fails.
+function nativeBridge.submitRender(kind, voxels, params)
+  local m = mod()
+  if not (m and m.submit_render) then return nil, "native missing" end
+  local ok, handle = pcall(m.submit_render, { mode = kind, voxels = voxels }, params)
+  if not ok or handle == nil then
+    if not nativeBridge._logOnce.submit_render_fail then
+      nativeBridge._logOnce.submit_render_fail = true
+      print("[asevoxel-native] submit_render FAILED, rendering synchronously: " .. tostring(handle))
+    end
+    return nil, handle
+  end
+  if not nativeBridge._logOnce.submit_render_ok then
+    nativeBridge._logOnce.submit_render_ok = true
+    print("[asevoxel-native] submit_render (native worker)")
+  end
+
+  local job = { state = "running" }
+  function job:poll()
+    if self.state ~= "running" then return self.state end
+    local okp, st = pcall(function() return handle:poll() end)
+    if not okp or st == "failed" then
+      self.state = "failed"
+    elseif st == true or st == "done" then
+      self.state = "done"
+    elseif st == "cancelled" then
+      self.state = "cancelled"
+    end
+    return self.state
+  end
+  function job:cancel()
+    if self.state ~= "running" then return end
+    pcall(function() handle:cancel() end)
+    self.state = "cancelled"
+  end
+  function job:result()
+    if self.state ~= "done" then return nil end
+    local okr, res = pcall(function() return handle:result() end)
+    if not okr or type(res) ~= "table" or type(res.pixels) ~= "string" then
+      self.state = "failed"
+      return nil, res
+    end
+    return res
+  end
+  return job
+end
+
+-- Multi-view render: one scene (voxels + shared params), N camera views.
+-- views: array of { xRotation, yRotation, zRotation [, matrix] }; the module
+-- parses/bins the voxels once and renders the views across its worker pool.
+-- Returns an array of { width, height, pixels } in view order, or nil when the
+-- module has no batch API or the call fails (callers render view by view).
+function nativeBridge.renderBatch(kind, voxels, params, views)
+  local m = mod()
+  if not (m and m.render_batch) then return nil, "native missing" end
+  local ok, res = pcall(m.render_batch, { mode = kind, voxels = voxels }, params, views)
+  if not ok or type(res) ~= "table" or #res ~= #views then
+    if not nativeBridge._logOnce.render_batch_fail then
+      nativeBridge._logOnce.render_batch_fail = true
+      print("[asevoxel-native] render_batch FAILED, rendering per view: " .. tostring(res))
+    end
+    return nil, res
+  end
+  if not nativeBridge._logOnce.render_batch_ok then
+    nativeBridge._logOnce.render_batch_ok = true
+    print("[asevoxel-native] render_batch (" .. #views .. " views)")
+  end
+  return res
+end
+
 --------------------------------------------------------------------------------
 -- Unload helpers: best-effort attempts to release loaded native DLLs so the
 -- extension folder can be removed on Windows/Unix. Unloading shared libs from
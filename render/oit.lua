@@ -0,0 +1,179 @@
+-- oit.lua
+-- Order-independent transparency for the Lua image path (weighted blended OIT).
+-- Opaque faces are drawn normally and record their depth per pixel; translucent
+-- faces then accumulate into per-pixel sums with a depth-based weight, tested
+-- against the opaque depth. A final resolve composites the sums over the image.
+-- Cost is O(covered pixels): translucent faces need no sort at all.
+
+local oit = {}
+
+oit.TRIM_FACTOR = 4
+
+-- Reused per-pixel buffers (grown on demand, reset per frame; resolve() drops
+-- them once they are far larger than the frame, e.g. after a big export)
+local _buf = {
+  width = 0, height = 0,
+  capacity = 0,        -- pixels the arrays currently hold
+  depth = {},          -- nearest opaque distance per pixel
+  accR = {}, accG = {}, accB = {}, accA = {},
+  reveal = {},         -- product of (1 - alpha) of translucent fragments
+  touched = {},        -- pixel indices with translucent coverage
+  touchedCount = 0,
+  near = 0
+}
+
+-- Span scratch (per row start/end x) for the quad coverage rule
+local _sx, _ex = {}, {}
+
+--------------------------------------------------------------------------------
+-- Coverage: same rule as drawConvexQuad (pixel centers, half-open on Y,
+-- inclusive X). Fills _sx/_ex per row; returns yMin, yMax (yMax < yMin if empty).
+--------------------------------------------------------------------------------
+local function quadSpans(pts, w, h)
+  local minY, maxY = math.huge, -math.huge
+  for i = 1, 4 do
+    local y = pts[i].y
+    if y < minY then minY = y end
+    if y > maxY then maxY = y end
+  end
+  minY = math.max(0, math.floor(minY))
+  maxY = math.min(h - 1, math.ceil(maxY))
+  for y = minY, maxY do
+    local scanY = y + 0.5
+    local lo, hi = math.huge, -math.huge
+    for i = 1, 4 do
+      local a = pts[i]
+      local b = pts[(i % 4) + 1]
+      local y0, y1, x0, x1 = a.y, b.y, a.x, b.x
+      if y0 > y1 then y0, y1, x0, x1 = y1, y0, x1, x0 end
+      if y0 ~= y1 and scanY >= y0 and scanY < y1 then
+        local x = x0 + (x1 - x0) * (scanY - y0) / (y1 - y0)
+        if x < lo then lo = x end
+        if x > hi then hi = x end
+      end
+    end
+    if lo <= hi then
+      local startX = math.max(0, math.floor(lo + 0.5))
+      local endX = math.min(w - 1, math.floor(hi - 0.5))
+      if endX < startX and (hi - lo) < 1.0 then endX = startX end
+      _sx[y], _ex[y] = startX, endX
+    else
+      _sx[y], _ex[y] = 1, 0
+    end
+  end
+  return minY, maxY
+end
+
+--------------------------------------------------------------------------------
+-- Frame setup
+-- near: distance of the closest model point (weights use depth past it)
+--------------------------------------------------------------------------------
+function oit.begin(width, height, near)
+  local b = _buf
+  local n = width * height
+  local depth, reveal = b.depth, b.reveal
+  for i = 1, n do
+    depth[i] = math.huge
+    reveal[i] = 1
+  end
+  if n > b.capacity then b.capacity = n end
+  b.width, b.height = width, height
+  b.touchedCount = 0
+  b.near = near or 0
+  return b
+end
+
+-- Record opaque coverage (face distance from camera, larger = farther)
+function oit.writeOpaqueDepth(b, pts, dist)
+  local w = b.width
+  local y0, y1 = quadSpans(pts, w, b.height)
+  local depth = b.depth
+  for y = y0, y1 do
+    local row = y * w + 1
+    for x = _sx[y], _ex[y] do
+      local i = row + x
+      if dist < depth[i] then depth[i] = dist end
+    end
+  end
+end
+
+-- Weight from McGuire & Bavoil (2013), eq. 7, on depth past the near point:
+-- alpha * clamp(10 / (1e-5 + (z/5)^2 + (z/200)^6), 1e-2, 3e3)
+local function weight(alpha, dist, near)
+  local z = dist - near + 1
+  if z < 0.01 then z = 0.01 end
+  local z5 = z / 5
+  local z200 = z / 200
+  local w = 10 / (1e-5 + z5 * z5 + z200 ^ 6)
+  if w < 1e-2 then w = 1e-2 elseif w > 3e3 then w = 3e3 end
+  return alpha * w
+end
+
+-- Accumulate a translucent face (r,g,b 0..255, a 0..1)
+function oit.accumulate(b, pts, dist, r, g, bl, a)
+  if a <= 0 then return end
+  local w = b.width
+  local y0, y1 = quadSpans(pts, w, b.height)
+  local depth, reveal = b.depth, b.reveal
+  local accR, accG, accB, accA = b.accR, b.accG, b.accB, b.accA
+  local touched = b.touched
+  local wt = weight(a, dist, b.near)
+  local wr, wg, wb = r * wt, g * wt, bl * wt
+  for y = y0, y1 do
+    local row = y * w + 1
+    for x = _sx[y], _ex[y] do
+      local i = row + x
+      if dist < depth[i] then
+        local rv = reveal[i]
+        if rv == 1 then
+          accR[i], accG[i], accB[i], accA[i] = 0, 0, 0, 0
+          local t = b.touchedCount + 1
+          b.touchedCount = t
+          touched[t] = i
+        end
+        accR[i] = accR[i] + wr
+        accG[i] = accG[i] + wg
+        accB[i] = accB[i] + wb
+        accA[i] = accA[i] + wt
+        reveal[i] = rv * (1 - a)
+      end
+    end
+  end
+end
+
+-- Composite accumulated translucency over the image (only touched pixels)
+function oit.resolve(b, image)
+  local pc = app.pixelColor
+  local w = b.width
+  local reveal = b.reveal
+  local accR, accG, accB, accA = b.accR, b.accG, b.accB, b.accA
+  local touched = b.touched
+  for k = 1, b.touchedCount do
+    local i = touched[k]
+    local rv = reveal[i]
+    local sumA = accA[i]
+    if rv < 1 and sumA > 0 then
+      local x = (i - 1) % w
+      local y = (i - 1) // w
+      local dst = image:getPixel(x, y)
+      local cover = 1 - rv
+      local dr, dg, db, da = pc.rgbaR(dst), pc.rgbaG(dst), pc.rgbaB(dst), pc.rgbaA(dst)
+      local r = (accR[i] / sumA) * cover + dr * rv
+      local g = (accG[i] / sumA) * cover + dg * rv
+      local bl = (accB[i] / sumA) * cover + db * rv
+      local a = 255 * cover + da * rv
+      image:putPixel(x, y, pc.rgba(
+        math.floor(r + 0.5), math.floor(g + 0.5), math.floor(bl + 0.5), math.floor(a + 0.5)))
+    end
+  end
+  b.touchedCount = 0
+  -- Keep at most TRIM_FACTOR frames' worth between frames of a similar size
+  local n = w * b.height
+  if b.capacity > oit.TRIM_FACTOR * n then
+    b.depth, b.reveal, b.touched = {}, {}, {}
+    b.accR, b.accG, b.accB, b.accA = {}, {}, {}, {}
+    b.capacity = 0
+  end
+end
+
+return oit
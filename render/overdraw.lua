@@ -0,0 +1,121 @@
+-- overdraw.lua
+-- Fill-rate instrumentation for the Lua image path. While a frame is being
+-- counted, drawConvexQuad adds every span it writes to a per-pixel write
+-- counter; finish() reduces the counts to summary statistics and heatmap()
+-- turns them into an overlay image (clear where nothing was drawn, blue for
+-- a single write through red at MAX_DEPTH writes and above).
+-- Translucent faces accumulated by oit.lua are not rasterized through
+-- drawConvexQuad and are not counted.
+
+local overdraw = {}
+
+overdraw.MAX_DEPTH = 8        -- heatmap and histogram saturate here
+
+-- Reused per-pixel counters (grown on demand, reset per frame)
+local _buf = { width = 0, height = 0, count = {}, faces = 0 }
+
+-- Heatmap ramp by write count (1 .. MAX_DEPTH)
+local RAMP = {
+  { 40, 90, 255, 110 },
+  { 0, 200, 255, 150 },
+  { 0, 220, 90, 170 },
+  { 170, 230, 0, 180 },
+  { 255, 230, 0, 190 },
+  { 255, 150, 0, 200 },
+  { 255, 70, 0, 210 },
+  { 230, 0, 90, 220 }
+}
+
+--------------------------------------------------------------------------------
+-- Counting
+--------------------------------------------------------------------------------
+function overdraw.begin(width, height)
+  local count = _buf.count
+  for i = 1, width * height do count[i] = 0 end
+  _buf.width, _buf.height, _buf.faces = width, height, 0
+  return _buf
+end
+
+-- One filled face (call once per rasterized quad)
+function overdraw.face(buf)
+  buf.faces = buf.faces + 1
+end
+
+-- Inclusive span [x0, x1] on row y, already clipped to the buffer
+function overdraw.span(buf, y, x0, x1)
+  local count = buf.count
+  local row = y * buf.width + 1
+  for i = row + x0, row + x1 do count[i] = count[i] + 1 end
+end
+
+--------------------------------------------------------------------------------
+-- Results
+--------------------------------------------------------------------------------
+-- pixelsWritten: total writes; pixelsCovered: pixels written at least once;
+-- wastedWrites: writes later overwritten; depthComplexity: mean writes (=
+-- faces) per covered pixel; histogram[d]: covered pixels with d writes
+-- (last bucket is MAX_DEPTH and above)
+function overdraw.finish(buf)
+  local maxD = overdraw.MAX_DEPTH
+  local hist = {}
+  for d = 1, maxD do hist[d] = 0 end
+  local count = buf.count
+  local written, covered, deepest = 0, 0, 0
+  for i = 1, buf.width * buf.height do
+    local c = count[i]
+    if c > 0 then
+      written = written + c
+      covered = covered + 1
+      if c > deepest then deepest = c end
+      local d = c < maxD and c or maxD
+      hist[d] = hist[d] + 1
+    end
+  end
+  local area = buf.width * buf.height
+  return {
+    pixelsWritten = written,
+    pixelsCovered = covered,
+    wastedWrites = written - covered,
+    depthComplexity = covered > 0 and written / covered or 0,
+    maxDepth = deepest,
+    faces = buf.faces,
+    pixelsPerFace = buf.faces > 0 and written / buf.faces or 0,
+    coverage = area > 0 and covered / area or 0,
+    histogram = hist
+  }
+end
+
+-- Heatmap Image at 1/ss of the counted resolution (each output pixel shows
+-- the deepest sample of its ss x ss block)
+function overdraw.heatmap(buf, ss)
+  ss = ss or 1
+  local w, h = buf.width // ss, buf.height // ss
+  local img = Image(w, h, ColorMode.RGB)
+  img:clear(Color(0, 0, 0, 0))
+  local pc = app.pixelColor
+  local colors = {}
+  for d = 1, overdraw.MAX_DEPTH do
+    local c = RAMP[d]
+    colors[d] = pc.rgba(c[1], c[2], c[3], c[4])
+  end
+  local maxD = overdraw.MAX_DEPTH
+  local count, bw = buf.count, buf.width
+  for oy = 0, h - 1 do
+    for ox = 0, w - 1 do
+      local deepest = 0
+      for ky = 0, ss - 1 do
+        local row = (oy * ss + ky) * bw + ox * ss + 1
+        for kx = 0, ss - 1 do
+          local c = count[row + kx]
+          if c > deepest then deepest = c end
+        end
+      end
+      if deepest > 0 then
+        img:putPixel(ox, oy, colors[deepest < maxD and deepest or maxD])
+      end
+    end
+  end
+  return img
+end
+
+return overdraw
@@ -40,6 +40,11 @@ end
 -- Backward compatibility: local variables that use lazy loaders
 local rotation, mathUtils, fxStackModule, nativeBridge, nativeBridge_ok, profiler
 local fastVisibility, vertexCache -- NEW: optimization modules
+local brickCache, depthSort, oit, frameCache, overdraw
+-- Coherent draw-order state for renderPreview (reused across drag frames)
+local _drawOrder = nil
+-- Per-pixel write counter while renderPreview counts overdraw (params.overdraw)
+local _overdraw = nil
 
 local function _initModules()
   if not rotation then
@@ -49,6 +54,11 @@ local function _initModules()
     profiler = getProfiler()
     fastVisibility = AseVoxel.render.fast_visibility
     vertexCache = AseVoxel.render.vertex_cache
+    brickCache = AseVoxel.render.brick_cache
+    depthSort = AseVoxel.render.depth_sort
+    oit = AseVoxel.render.oit
+    frameCache = AseVoxel.render.frame_cache
+    overdraw = AseVoxel.render.overdraw
     local nb = getNativeBridge()
     if nb and nb.isAvailable then
       nativeBridge = nb
@@ -320,6 +330,7 @@ end
 --------------------------------------------------------------------------------
 -- Utility: Quaternion helpers (for lighting normal rotation only)
 --------------------------------------------------------------------------------
+-- Returns qw, qx, qy, qz (scalars: called once per frame, nothing allocated)
 local function eulerToQuat(xDeg, yDeg, zDeg)
   local xr, yr, zr = math.rad(xDeg or 0), math.rad(yDeg or 0), math.rad(zDeg or 0)
   -- ZYX order (matches existing combination: Z * Y * X)
@@ -332,28 +343,29 @@ local function eulerToQuat(xDeg, yDeg, zDeg)
   local qx = cz*cy*sx - sz*sy*cx
   local qy = cz*sy*cx + sz*cy*sx
   local qz = sz*cy*cx - cz*sy*sx
-  return {w=qw,x=qx,y=qy,z=qz}
+  return qw, qx, qy, qz
 end
 
-local function quatRotateVec(q, v)
+local function quatRotateVec(qw, qx, qy, qz, vx, vy, vz)
   -- v' = q * (0,v) * q^-1
-  local qw,qx,qy,qz = q.w, q.x, q.y, q.z
-  local vx,vy,vz = v.x, v.y, v.z
   -- Compute cross products directly (optimized)
   local tx  = 2*(qy*vz - qz*vy)
   local ty  = 2*(qz*vx - qx*vz)
   local tz  = 2*(qx*vy - qy*vx)
-  return {
-    x = vx + qw*tx + (qy*tz - qz*ty),
-    y = vy + qw*ty + (qz*tx - qx*tz),
-    z = vz + qw*tz + (qx*ty - qy*tx)
-  }
+  return vx + qw*tx + (qy*tz - qz*ty),
+         vy + qw*ty + (qz*tx - qx*tz),
+         vz + qw*tz + (qx*ty - qy*tx)
 end
 
-local function normalize(v)
-  local l = math.sqrt(v.x*v.x + v.y*v.y + v.z*v.z)
-  if l < 1e-6 then return {x=0,y=0,z=1} end
-  return {x=v.x/l,y=v.y/l,z=v.z/l}
+-- Normalizes (x, y, z) into out
+local function normalizeInto(out, x, y, z)
+  local l = math.sqrt(x*x + y*y + z*z)
+  if l < 1e-6 then
+    out.x, out.y, out.z = 0, 0, 1
+  else
+    out.x, out.y, out.z = x/l, y/l, z/l
+  end
+  return out
 end
 
 local previewRenderer = {}
@@ -370,14 +382,102 @@ local UNIT_CUBE_VERTICES = {
 }
 
 local FACE_DEFS = {
-  {indices = {5, 6, 7, 8}, name = "front"},
-  {indices = {2, 1, 4, 3}, name = "back"},
-  {indices = {6, 2, 3, 7}, name = "right"},
-  {indices = {1, 5, 8, 4}, name = "left"},
-  {indices = {8, 7, 3, 4}, name = "top"},
-  {indices = {1, 2, 6, 5}, name = "bottom"}
+  {indices = {5, 6, 7, 8}, name = "front", bit = 1},
+  {indices = {2, 1, 4, 3}, name = "back", bit = 2},
+  {indices = {6, 2, 3, 7}, name = "right", bit = 4},
+  {indices = {1, 5, 8, 4}, name = "left", bit = 8},
+  {indices = {8, 7, 3, 4}, name = "top", bit = 16},
+  {indices = {1, 2, 6, 5}, name = "bottom", bit = 32}
 }
 
+-- Face visibility / hidden-face masks: one bit per face (same bits as
+-- brick_cache hiddenMask), so the draw loop never copies face tables
+local FACE_BIT = {}
+for _, f in ipairs(FACE_DEFS) do FACE_BIT[f.name] = f.bit end
+local POPCOUNT = {}
+for m = 0, 63 do
+  local c = 0
+  for b = 0, 5 do if m & (1 << b) ~= 0 then c = c + 1 end end
+  POPCOUNT[m] = c
+end
+
+-- {front=true,...} -> mask
+local function faceMask(t)
+  local m = 0
+  if t then
+    for name, on in pairs(t) do
+      if on then m = m | (FACE_BIT[name] or 0) end
+    end
+  end
+  return m
+end
+
+--------------------------------------------------------------------------------
+-- Frame scratch (Lua image path)
+-- Everything the draw loop touches per voxel or per face lives here and is
+-- reused frame to frame, so a steady drag allocates nothing in the loop
+-- (metrics.drawAllocKB).
+--------------------------------------------------------------------------------
+-- Draw list: one slot per surface voxel across parallel number arrays
+-- (transformed / model position, packed RGBA, hidden mask, depth); _order
+-- holds the slots back to front.
+local _tx, _ty, _tz = {}, {}, {}
+local _vx, _vy, _vz = {}, {}, {}
+local _rgba, _hidden, _depth = {}, {}, {}
+local _order = {}          -- this frame's draw order (slot indices)
+local _glass = {}          -- translucent slots while splitting for OIT
+local _tv = { x = 0, y = 0, z = 0 }   -- transformed position of the slot being drawn
+local function _fartherSlot(a, b) return _depth[a] > _depth[b] end
+-- calculateFaceVisibility rotation params (per-voxel fallback only)
+local _visParams = { xRotation = 0, yRotation = 0, zRotation = 0, voxelSize = 1 }
+-- Profiled frames stop the collector for an exact metrics.drawAllocKB;
+-- the guard restarts it when renderPreview leaves, by return or by error
+local _gcStopped = false
+local _gcGuard = setmetatable({}, { __close = function()
+  if _gcStopped then
+    collectgarbage("restart")
+    _gcStopped = false
+  end
+end })
+
+-- Frame transform for _pushSlot (set once per frame by renderPreview):
+-- model center, camera position and the XYZ rotation's sines/cosines
+local _mpx, _mpy, _mpz, _camX, _camY, _camZ = 0, 0, 0, 0, 0, 0
+local _rcx, _rsx, _rcy, _rsy, _rcz, _rsz = 1, 0, 1, 0, 1, 0
+local _slots = 0
+
+-- Appends one voxel to the draw list (same math as rotation.transformVoxel)
+local function _pushSlot(vx, vy, vz, rgba, hiddenMask)
+  local x, y, z = vx - _mpx, vy - _mpy, vz - _mpz
+  local y2 = y * _rcx - z * _rsx
+  local z2 = y * _rsx + z * _rcx
+  y, z = y2, z2
+  local x2 = x * _rcy + z * _rsy
+  local z3 = -x * _rsy + z * _rcy
+  x, z = x2, z3
+  local x3 = x * _rcz - y * _rsz
+  local y3 = x * _rsz + y * _rcz
+  local tx, ty, tz = x3 + _mpx, y3 + _mpy, z + _mpz
+  local dx = (tx + 0.5) - _camX
+  local dy = (ty + 0.5) - _camY
+  local dz = (tz + 0.5) - _camZ
+  local n = _slots + 1
+  _slots = n
+  _tx[n], _ty[n], _tz[n] = tx, ty, tz
+  _vx[n], _vy[n], _vz[n] = vx, vy, vz
+  _rgba[n], _hidden[n] = rgba, hiddenMask
+  _depth[n] = dx*dx + dy*dy + dz*dz
+end
+local _screen = {}         -- 8 projected cube corners { x, y, z, d }
+for i = 1, 8 do _screen[i] = { x = 0, y = 0, z = 0, d = 0 } end
+local _pts = {}            -- current face quad (refs into _screen)
+local _faceOrder = {}      -- face indices, sorted far to near
+local _faceDepth = {}
+local function _fartherFace(a, b) return _faceDepth[a] > _faceDepth[b] end
+-- Scanline edges / intersections for drawConvexQuad (a quad has <= 4 of each)
+local _ex0, _ey0, _ex1, _ey1, _xi = {}, {}, {}, {}, {}
+local _cullView, _visibleBricks = {}, {}   -- brickCache.cullBricks view / result
+
 local RAINBOW_COLORS = {
   front  = Color(255,255,255),
   back   = Color(255,255,0),
@@ -570,7 +670,11 @@ function previewRenderer.generateVoxelModel(sprite)
     return model
   end
 
-  -- Standard path
+  -- Standard path (timeline cache: unchanged frames return the same model)
+  local timelineCache = AseVoxel.render.timeline_cache
+  if timelineCache and timelineCache.enabled then
+    return timelineCache.getModel(sprite, _activeFrameNumber())
+  end
   local model = {}
   local visibleLayers = {}
   for _, layer in ipairs(sprite.layers) do
@@ -611,6 +715,10 @@ end
 -- Geometry Helpers
 --------------------------------------------------------------------------------
 function previewRenderer.calculateModelBounds(model)
+  -- Buffer-backed models track their bounds
+  local vb = AseVoxel.render.voxel_buffer
+  local buf = vb.peek(model)
+  if buf and buf.n > 0 then return vb.bounds(buf) end
   local b = { minX=math.huge, maxX=-math.huge,
               minY=math.huge, maxY=-math.huge,
               minZ=math.huge, maxZ=-math.huge }
@@ -709,17 +817,17 @@ end
 --------------------------------------------------------------------------------
 -- Basic Mode Brightness (Formula B implementation)
 --------------------------------------------------------------------------------
-local function basicModeBrightness(faceName, rotationMatrix, viewDir, params)
+local function basicModeBrightness(faceName, rotationMatrix, vdx, vdy, vdz, params)
   local n = FACE_NORMALS[faceName]
   if not n then return 1 end
-  local nn = {
-    rotationMatrix[1][1]*n[1] + rotationMatrix[1][2]*n[2] + rotationMatrix[1][3]*n[3],
-    rotationMatrix[2][1]*n[1] + rotationMatrix[2][2]*n[2] + rotationMatrix[2][3]*n[3],
-    rotationMatrix[3][1]*n[1] + rotationMatrix[3][2]*n[2] + rotationMatrix[3][3]*n[3],
-  }
-  local mag = math.sqrt(nn[1]*nn[1]+nn[2]*nn[2]+nn[3]*nn[3])
-  if mag > 1e-6 then nn[1],nn[2],nn[3] = nn[1]/mag, nn[2]/mag, nn[3]/mag end
-  local dot = nn[1]*viewDir[1] + nn[2]*viewDir[2] + nn[3]*viewDir[3]
+  local n1, n2, n3 = n[1], n[2], n[3]
+  local r1, r2, r3 = rotationMatrix[1], rotationMatrix[2], rotationMatrix[3]
+  local nx = r1[1]*n1 + r1[2]*n2 + r1[3]*n3
+  local ny = r2[1]*n1 + r2[2]*n2 + r2[3]*n3
+  local nz = r3[1]*n1 + r3[2]*n2 + r3[3]*n3
+  local mag = math.sqrt(nx*nx+ny*ny+nz*nz)
+  if mag > 1e-6 then nx,ny,nz = nx/mag, ny/mag, nz/mag end
+  local dot = nx*vdx + ny*vdy + nz*vdz
   if dot <= 0 then dot = 0 end
 
   -- Basic shading formula B:
@@ -822,24 +930,32 @@ end
 --  3. Rounding before fill produced "chipped" top-right corners.
 -- New approach: scanline fill of convex quad using float vertices, half-open rule on Y, inclusive X.
 -- If drawing to GraphicsContext (DirectCanvas mode), use path API instead
+-- color: Color, {r,g,b,a} or a packed pixel value (the renderer's own faces)
+local _gcTarget, _gcIs = nil, false
+local function isGraphicsContext(target)
+  if target ~= _gcTarget then
+    _gcTarget = target
+    _gcIs = false
+    if type(target) == "userdata" then
+      -- Safe check for beginPath method existence
+      local ok, result = pcall(function() return target.beginPath ~= nil end)
+      _gcIs = ok and result or false
+    end
+  end
+  return _gcIs
+end
+
 local function drawConvexQuad(target, pts, color)
-  -- Check if target is a GraphicsContext (try accessing a method safely)
-  local isGraphicsContext = false
-  if type(target) == "userdata" then
-    -- Safe check for beginPath method existence
-    local ok, result = pcall(function() return target.beginPath ~= nil end)
-    if ok and result then
-      isGraphicsContext = true
-    end
-  end
-  
-  if isGraphicsContext then
+  if isGraphicsContext(target) then
     -- DirectCanvas: Use GraphicsContext path API (FAST!)
     if #pts ~= 4 then return end -- Only quads supported
     
-    -- Convert color table to Color object if needed
+    -- Convert color table / pixel value to Color object if needed
     local finalColor
-    if type(color) == "table" and not getmetatable(color) then
+    if type(color) == "number" then
+      local pc = app.pixelColor
+      finalColor = Color(pc.rgbaR(color), pc.rgbaG(color), pc.rgbaB(color), pc.rgbaA(color))
+    elseif type(color) == "table" and not getmetatable(color) then
       -- Ensure alpha is 255 if not specified
       local alpha = color.a or color.alpha or 255
       finalColor = Color(
@@ -869,7 +985,6 @@ local function drawConvexQuad(target, pts, color)
     else
       -- GraphicsContext failed, fall through to software rasterizer
       print("[AseVoxel] GraphicsContext rendering failed: " .. tostring(err))
-      isGraphicsContext = false
     end
   end
   
@@ -898,50 +1013,65 @@ local function drawConvexQuad(target, pts, color)
     end
     return
   end
+  if _overdraw then overdraw.face(_overdraw) end
 
   local minY, maxY = math.huge, -math.huge
-  for _,p in ipairs(pts) do
-    if p.y < minY then minY = p.y end
-    if p.y > maxY then maxY = p.y end
+  for i = 1, 4 do
+    local py = pts[i].y
+    if py < minY then minY = py end
+    if py > maxY then maxY = py end
   end
   minY = math.max(0, math.floor(minY))
   maxY = math.min(image.height-1, math.ceil(maxY))
 
-  local edges = {}
+  -- Non-horizontal edges, oriented top to bottom
+  local ex0, ey0, ex1, ey1 = _ex0, _ey0, _ex1, _ey1
+  local ne = 0
   for i=1,4 do
     local a = pts[i]
     local b = pts[(i % 4)+1]
     if a.y ~= b.y then
+      ne = ne + 1
       if a.y < b.y then
-        edges[#edges+1] = { y0=a.y, y1=b.y, x0=a.x, x1=b.x }
+        ey0[ne], ey1[ne], ex0[ne], ex1[ne] = a.y, b.y, a.x, b.x
       else
-        edges[#edges+1] = { y0=b.y, y1=a.y, x0=b.x, x1=a.x }
+        ey0[ne], ey1[ne], ex0[ne], ex1[ne] = b.y, a.y, b.x, a.x
       end
     end
   end
 
+  local xInts = _xi
+  local imgW = image.width
   for y = minY, maxY do
     local scanY = y + 0.5
-    local xInts = {}
-    for _,e in ipairs(edges) do
-      if scanY >= e.y0 and scanY < e.y1 then
-        local t = (scanY - e.y0) / (e.y1 - e.y0)
-        local x = e.x0 + (e.x1 - e.x0) * t
-        xInts[#xInts+1] = x
+    local nx = 0
+    for e = 1, ne do
+      local y0 = ey0[e]
+      if scanY >= y0 and scanY < ey1[e] then
+        local t = (scanY - y0) / (ey1[e] - y0)
+        local x = ex0[e] + (ex1[e] - ex0[e]) * t
+        -- insertion into the sorted prefix (<= 4 entries)
+        local k = nx
+        while k >= 1 and xInts[k] > x do
+          xInts[k + 1] = xInts[k]
+          k = k - 1
+        end
+        xInts[k + 1] = x
+        nx = nx + 1
       end
     end
-    if #xInts >= 2 then
-      table.sort(xInts)
-      for k=1,#xInts,2 do
+    if nx >= 2 then
+      for k=1,nx,2 do
         local x0 = xInts[k]
-        local x1 = xInts[k+1] or x0
+        local x1 = (k + 1 <= nx) and xInts[k+1] or x0
         if x1 < x0 then x0,x1 = x1,x0 end
         local startX = math.max(0, math.floor(x0 + 0.5))
-        local endX   = math.min(image.width-1, math.floor(x1 - 0.5))
+        local endX   = math.min(imgW-1, math.floor(x1 - 0.5))
         if endX < startX and (math.abs(x1 - x0) < 1.0) then endX = startX end
         for xPix = startX, endX do
           image:putPixel(xPix, y, color)
         end
+        if _overdraw and endX >= startX then overdraw.span(_overdraw, y, startX, endX) end
       end
     end
   end
@@ -955,7 +1085,27 @@ end
 -- Core Shaded Face Drawing (updated for Basic/Dynamic/Stack modes)
 --------------------------------------------------------------------------------
 -- Replaced shadeFaceColor with unified implementation (supports legacy aliases + cache)
-local function shadeFaceColor(faceName, baseColor, params)
+-- Works on integer channels and returns a packed pixel value, so shading a
+-- face allocates nothing. Stack results depend only on (color, face) within
+-- a frame and are memoized per frame (beginShadeFrame).
+local WHITE_LIGHT = {r=1,g=1,b=1}
+local _fxCtx = { rotationMatrix = nil, viewDir = nil, fxStack = nil }
+local _fxColor = { r = 0, g = 0, b = 0, a = 255 }
+local _stackMemo = {}
+
+local function clamp8(v)
+  v = math.floor(v + 0.5)
+  return v < 0 and 0 or (v > 255 and 255 or v)
+end
+
+local function beginShadeFrame(params)
+  for k in pairs(_stackMemo) do _stackMemo[k] = nil end
+  _fxCtx._frameIsoCache = nil   -- fx_stack's per-frame iso role cache
+  _fxCtx.rotationMatrix, _fxCtx.viewDir, _fxCtx.fxStack = nil, nil, params.fxStack
+end
+
+local function shadeFacePixel(faceName, faceIdx, baseR, baseG, baseB, baseA, params)
+  local rgba = app.pixelColor.rgba
   local shadingMode = params.shadingMode or "Stack"
   -- Normalize legacy aliases
   if shadingMode == "Complete" then shadingMode = "Dynamic" end
@@ -963,21 +1113,13 @@ local function shadeFaceColor(faceName, baseColor, params)
 
   -- None mode: bypass all lighting calculations for performance baseline
   if shadingMode == "None" then
-    return baseColor
+    return rgba(baseR, baseG, baseB, baseA)
   end
 
   -- Dynamic lighting mode (standalone)
   if shadingMode == "Dynamic" then
-    -- Accept legacy AND newer field names to avoid silent fallback
     local lighting = params.lighting
-    -- dynamicLighting (older) vs dyn (newer)
-    local dyn = params.dynamicLighting or params.dyn
-    -- rotatedFaceNormals (older) vs rotatedNormals (alternate path in drawVoxel)
-    local rotatedNormals = params.rotatedFaceNormals or params.rotatedNormals
-    -- Per‑voxel vector name harmonization: lightVector (apex) else fallback to directional dyn.lightDir
-    local L = params.lightVector or (dyn and dyn.lightDir)
-
-    if not lighting then return baseColor end
+    if not lighting then return rgba(baseR, baseG, baseB, baseA) end
 
     -- Primary cache: lighting._cache (choice 1:A). Accept legacy fallbacks.
     local cache = lighting._cache
@@ -985,12 +1127,12 @@ local function shadeFaceColor(faceName, baseColor, params)
                  or params.dyn
                  or params.dynamicLighting
     if not cache or not cache.rotatedNormals or not cache.lightDir then
-      return baseColor
+      return rgba(baseR, baseG, baseB, baseA)
     end
 
     local normal = cache.rotatedNormals[faceName]
                    or (cache.rotatedFaceNormals and cache.rotatedFaceNormals[faceName])
-    if not normal then return baseColor end
+    if not normal then return rgba(baseR, baseG, baseB, baseA) end
 
     -- Lambert term
     local ndotl = normal.x * cache.lightDir.x + normal.y * cache.lightDir.y + normal.z * cache.lightDir.z
@@ -1008,11 +1150,7 @@ local function shadeFaceColor(faceName, baseColor, params)
     if shadow == nil then shadow = 1 end
     diffuse = diffuse * shadow
 
-    local baseR = baseColor.red or baseColor.r or 255
-    local baseG = baseColor.green or baseColor.g or 255
-    local baseB = baseColor.blue or baseColor.b or 255
-
-    local lc = cache.lightColor or {r=1,g=1,b=1}
+    local lc = cache.lightColor or WHITE_LIGHT
     local lr, lg, lb = (lc.r or 1), (lc.g or 1), (lc.b or 1)
     local ambient = cache.ambient or 0
 
@@ -1049,7 +1187,7 @@ local function shadeFaceColor(faceName, baseColor, params)
     r = (r < 0 and 0) or (r > 255 and 255 or math.floor(r + 0.5))
     g = (g < 0 and 0) or (g > 255 and 255 or math.floor(g + 0.5))
     b = (b < 0 and 0) or (b > 255 and 255 or math.floor(b + 0.5))
-    return Color(r, g, b, baseColor.alpha or baseColor.a or 255)
+    return rgba(r, g, b, baseA)
   end
 
   -- Basic mode (renamed)
@@ -1063,55 +1201,90 @@ local function shadeFaceColor(faceName, baseColor, params)
     local vd = params.viewDir
     local mag = math.sqrt(vd.x*vd.x+vd.y*vd.y+vd.z*vd.z)
     if mag > 1e-6 then vd.x,vd.y,vd.z = vd.x/mag, vd.y/mag, vd.z/mag end
-    local b = basicModeBrightness(faceName, M, {vd.x,vd.y,vd.z}, params)
-    local r = math.floor((baseColor.red or baseColor.r) * b + 0.5)
-    local g = math.floor((baseColor.green or baseColor.g) * b + 0.5)
-    local bl = math.floor((baseColor.blue or baseColor.b) * b + 0.5)
-    return Color(r,g,bl, baseColor.alpha or baseColor.a or 255)
+    local b = basicModeBrightness(faceName, M, vd.x, vd.y, vd.z, params)
+    local r = math.floor(baseR * b + 0.5)
+    local g = math.floor(baseG * b + 0.5)
+    local bl = math.floor(baseB * b + 0.5)
+    return rgba(r, g, bl, baseA)
   end
 
   -- Stack mode (FX)
   if shadingMode == "Stack" and params.fxStack and params.fxStack.modules and #params.fxStack.modules > 0 then
+    local key = rgba(baseR, baseG, baseB, baseA) * 8 + faceIdx
+    local px = _stackMemo[key]
+    if px then return px end
     if not params._rotationMatrixForFX then
       params._rotationMatrixForFX =
         mathUtils.createRotationMatrix(params.xRotation or 0, params.yRotation or 0, params.zRotation or 0)
     end
     params.viewDir = params.viewDir or {x=0,y=0,z=1}
-    local shaded = fxStackModule.shadeFace({
-        rotationMatrix = params._rotationMatrixForFX,
-        viewDir = params.viewDir,
-        fxStack = params.fxStack
-      },
-      faceName,
-      {
-        r = baseColor.red or baseColor.r,
-        g = baseColor.green or baseColor.g,
-        b = baseColor.blue or baseColor.b,
-        a = baseColor.alpha or baseColor.a or 255
-      }
-    )
-    return Color(shaded.r, shaded.g, shaded.b, shaded.a)
+    _fxCtx.rotationMatrix = params._rotationMatrixForFX
+    _fxCtx.viewDir = params.viewDir
+    _fxCtx.fxStack = params.fxStack
+    _fxColor.r, _fxColor.g, _fxColor.b, _fxColor.a = baseR, baseG, baseB, baseA
+    local shaded = fxStackModule.shadeFace(_fxCtx, faceName, _fxColor)
+    px = rgba(clamp8(shaded.r), clamp8(shaded.g), clamp8(shaded.b), clamp8(shaded.a or 255))
+    _stackMemo[key] = px
+    return px
   end
 
-  return baseColor
+  return rgba(baseR, baseG, baseB, baseA)
+end
+
+-- Face normals for dynamic lighting, rotated once per frame (drawVoxel used
+-- to rebuild them for every voxel) into tables reused across frames
+local FACE_NORMALS_LOCAL = {
+  front  = {x=0,y=0,z=1},
+  back   = {x=0,y=0,z=-1},
+  right  = {x=1,y=0,z=0},
+  left   = {x=-1,y=0,z=0},
+  top    = {x=0,y=1,z=0},
+  bottom = {x=0,y=-1,z=0}
+}
+local DEFAULT_LIGHT_DIR = {x=0.55,y=0.75,z=0.35}
+local _rotatedNormals = {}
+for name in pairs(FACE_NORMALS_LOCAL) do _rotatedNormals[name] = {x=0,y=0,z=1} end
+local _lightDir = {x=0,y=0,z=1}
+
+local function prepareFaceNormals(params)
+  local lighting = params.lighting
+  if lighting and (lighting.enabled == false or lighting.mode == "off"
+                   or (lighting.mode and lighting.mode ~= "dynamic")) then
+    return
+  end
+  -- Rotate normals with quaternion for accurate lighting
+  local qw, qx, qy, qz = eulerToQuat(params.xRotation, params.yRotation, params.zRotation)
+  for name, n in pairs(FACE_NORMALS_LOCAL) do
+    normalizeInto(_rotatedNormals[name], quatRotateVec(qw, qx, qy, qz, n.x, n.y, n.z))
+  end
+  local ld = (lighting and lighting.lightDir) or DEFAULT_LIGHT_DIR
+  params.rotatedNormals = _rotatedNormals
+  params.lightDir = normalizeInto(_lightDir, ld.x, ld.y, ld.z)
 end
 
 -- Updated drawVoxel to apply true perspective (FOV-based) projection.
 -- Now accepts either Image or GraphicsContext as first parameter
+-- color: packed RGBA integer (voxel_buffer layout) or an {r,g,b,a} table.
+-- faceVisibility: face mask (FACE_DEFS bits) or a {front=true,...} table.
+-- Projects into the shared _screen corners and fills from shared scratch;
+-- nothing is allocated per voxel.
 function previewRenderer.drawVoxel(target, x, y, size, color, faceVisibility, params, tv, middlePoint, camera)
-  local baseColor = Color(color.r, color.g, color.b, color.a or 255)
-
-  -- Prepare per-face base colors (original color only)
-  local faceBase = {}
-  for faceName, _ in pairs(faceVisibility) do
-    faceBase[faceName] = baseColor
+  local mask = faceVisibility
+  if type(mask) ~= "number" then mask = faceMask(mask) end
+  if mask == 0 then return end
+  local baseR, baseG, baseB, baseA
+  if math.type(color) == "integer" then
+    baseR, baseG, baseB, baseA = (color >> 24) & 255, (color >> 16) & 255, (color >> 8) & 255, color & 255
+  else
+    baseR, baseG, baseB = clamp8(color.r), clamp8(color.g), clamp8(color.b)
+    baseA = clamp8(color.a or 255)
   end
 
   local xRad = math.rad(params.xRotation or 0)
   local yRad = math.rad(params.yRotation or 0)
   local zRad = math.rad(params.zRotation or 0)
 
-  local screenVertices = {}
+  local screenVertices = _screen
   local cx, sx = math.cos(xRad), math.sin(xRad)
   local cy, sy = math.cos(yRad), math.sin(yRad)
   local cz, sz = math.cos(zRad), math.sin(zRad)
@@ -1123,9 +1296,13 @@ function previewRenderer.drawVoxel(target, x, y, size, color, faceVisibility, pa
   local isPersp = (not params.orthogonal) and camera and camera.focalLength
   local cxScr = camera and camera.centerX or 0
   local cyScr = camera and camera.centerY or 0
+  -- Weighted-blended transparency pass (set up by renderPreview)
+  local oitBuf = params._oit
+  local camZ = camera and camera.posZ or (mp.z + (params._cameraDistance or 0))
 
   -- NOTE: keep full float precision until rasterization (fix fractional scale artifacts)
-  for i, v in ipairs(UNIT_CUBE_VERTICES) do
+  for i = 1, 8 do
+    local v = UNIT_CUBE_VERTICES[i]
     local vx_local = v[1] * size
     local vy_local = v[2] * size
     local vz_local = v[3] * size
@@ -1138,12 +1315,7 @@ function previewRenderer.drawVoxel(target, x, y, size, color, faceVisibility, pa
     vx_local, vz_local = x2, z3
     local x3 = vx_local * cz - vy_local * sz
     local y3 = vx_local * sz + vy_local * cz
-    local rx, ry, rz = x3, y3, vz_local
 
-    local perspective = 1
-    if not params.orthogonal then
-      perspective = 1 / (1 - rz * 0.001)
-    end
     local relX_px = centerOffX_px + x3
     local relY_px = centerOffY_px + y3
     local relZ_units = centerOffZ_units + (vz_local / size)
@@ -1161,58 +1333,46 @@ function previewRenderer.drawVoxel(target, x, y, size, color, faceVisibility, pa
       syp = y + y3
       depthTag = relZ_units
     end
-    screenVertices[i] = { x = sxp, y = syp, z = depthTag }
+    local sv = screenVertices[i]
+    sv.x, sv.y, sv.z, sv.d = sxp, syp, depthTag, camZ - (tv.z + vz_local / size)
   end
 
   -- Depth sort faces (farther first) by avg Z
-  local sorted = {}
-  for _, face in ipairs(FACE_DEFS) do
+  local order, faceDepth = _faceOrder, _faceDepth
+  for f = 1, 6 do
+    local idx = FACE_DEFS[f].indices
     local avgZ = 0
-    for _, idx in ipairs(face.indices) do
-      avgZ = avgZ + screenVertices[idx].z
+    for k = 1, 4 do
+      avgZ = avgZ + screenVertices[idx[k]].z
     end
-    avgZ = avgZ / 4
-    sorted[#sorted+1] = { face=face, depth=avgZ }
+    faceDepth[f] = avgZ / 4
+    order[f] = f
   end
   -- Painter's algorithm: draw farther faces first (larger depth values first)
-  table.sort(sorted, function(a,b) return a.depth > b.depth end)
-
-  -- Prepare lighting (if enabled)
-  local lighting = params.lighting or {}
-  local lightMode = (lighting.enabled == false or lighting.mode == "off") and "off" or (lighting.mode or "dynamic")
-  local lightDir = lighting.lightDir
-  local rotatedNormals = {}
-  
-  if lightMode == "dynamic" then
-    -- Prepare face normals in model space
-    local faceNormalsLocal = {
-      front  = {x=0,y=0,z=1},
-      back   = {x=0,y=0,z=-1},
-      right  = {x=1,y=0,z=0},
-      left   = {x=-1,y=0,z=0},
-      top    = {x=0,y=1,z=0},
-      bottom = {x=0,y=-1,z=0}
-    }
-    
-    -- Rotate normals with quaternion for accurate lighting
-    local qRot = eulerToQuat(params.xRotation, params.yRotation, params.zRotation)
-    for name, n in pairs(faceNormalsLocal) do
-      rotatedNormals[name] = normalize(quatRotateVec(qRot, n))
-    end
-    
-    params.rotatedNormals = rotatedNormals
-    params.lightDir = normalize(lightDir or {x=0.55,y=0.75,z=0.35})
-  end
-
-  for _, item in ipairs(sorted) do
-    local face = item.face
-    if faceVisibility[face.name] then
-      local pts = {}
-      for _, idx in ipairs(face.indices) do
-        pts[#pts+1] = screenVertices[idx]
+  table.sort(order, _fartherFace)
+
+  local pc = app.pixelColor
+  local pts = _pts
+  for k = 1, 6 do
+    local f = order[k]
+    local face = FACE_DEFS[f]
+    if mask & face.bit ~= 0 then
+      local idx = face.indices
+      pts[1], pts[2], pts[3], pts[4] =
+        screenVertices[idx[1]], screenVertices[idx[2]], screenVertices[idx[3]], screenVertices[idx[4]]
+      local px = shadeFacePixel(face.name, f, baseR, baseG, baseB, baseA, params)
+      if oitBuf then
+        local dist = (pts[1].d + pts[2].d + pts[3].d + pts[4].d) / 4
+        local alpha = pc.rgbaA(px)
+        if alpha < 255 then
+          oit.accumulate(oitBuf, pts, dist, pc.rgbaR(px), pc.rgbaG(px), pc.rgbaB(px), alpha / 255)
+        else
+          previewRenderer.drawPolygon(target, pts, px, params.interpolationMethod or "Nearest Neighbor", size)
+          oit.writeOpaqueDepth(oitBuf, pts, dist)
+        end
+      else
+        previewRenderer.drawPolygon(target, pts, px, params.interpolationMethod or "Nearest Neighbor", size)
       end
-      local shadedColor = shadeFaceColor(face.name, faceBase[face.name], params)
-      previewRenderer.drawPolygon(target, pts, shadedColor, params.interpolationMethod or "Nearest Neighbor", size)
     end
   end
 end
@@ -1221,6 +1381,7 @@ end
 -- Main Preview Render
 --------------------------------------------------------------------------------
 function previewRenderer.renderPreview(model, params)
+  _initModules()  -- DirectCanvas calls in here without going through renderVoxelModel
   params = params or {}
   local _t_start = _nowMs()
   
@@ -1254,6 +1415,10 @@ function previewRenderer.renderPreview(model, params)
   if params.scale < 1 then
     ss = math.ceil(1 / params.scale)
   end
+  -- Quality governor may cap supersampling for interactive frames
+  if params.maxSupersample then
+    ss = math.max(1, math.min(ss, params.maxSupersample))
+  end
   local width  = outW * ss
   local height = outH * ss
   
@@ -1285,8 +1450,10 @@ function previewRenderer.renderPreview(model, params)
   end
 
   -- Profile: Model bounds calculation
+  -- Brick grid carries bounds + per-brick surfaces; only dirty bricks are rebuilt
   if enableProfiling and profiler then profiler.mark("bounds_calculation") end
-  local bounds = previewRenderer.calculateModelBounds(model)
+  local grid = brickCache and brickCache.update(model)
+  local bounds = grid and grid.bounds or previewRenderer.calculateModelBounds(model)
   if enableProfiling and profiler then profiler.measure("bounds_calculation") end
   
   local middlePoint = {
@@ -1301,7 +1468,9 @@ function previewRenderer.renderPreview(model, params)
   local diagModel = math.sqrt(modelWidth*modelWidth + modelHeight*modelHeight + modelDepth*modelDepth)
   local modelRadiusApprox = 0.5 * diagModel
 
-  local centerX, centerY = width/2, height/2
+  -- Pan offsets (DirectCanvas passes previewOffsetX/Y) are in output pixels
+  local centerX = width/2 + (params.offsetX or 0) * ss
+  local centerY = height/2 + (params.offsetY or 0) * ss
 
   local baseUnitSize = 1
   local voxelSize = math.max(1, baseUnitSize * (params.scale * ss))
@@ -1394,35 +1563,87 @@ function previewRenderer.renderPreview(model, params)
   -- Optimize / hidden faces
   if enableProfiling and profiler then profiler.mark("adjacency_culling") end
   local _t_opt_start = _nowMs()
-  local optimized = rotation.optimizeVoxelModel(model)
-  if _metrics then _metrics.t_optimize_ms = _nowMs() - _t_opt_start end
+  local optimized = (not grid) and rotation.optimizeVoxelModel(model) or nil
+  if _metrics then
+    _metrics.t_optimize_ms = _nowMs() - _t_opt_start
+    _metrics.bricks = grid and #grid.list or 0
+    _metrics.bricksRebuilt = grid and grid.rebuilt or 0
+  end
   if enableProfiling and profiler then profiler.measure("adjacency_culling") end
 
   -- Depth sort
   if enableProfiling and profiler then profiler.mark("transform_and_sort") end
   local _t_sort_start = _nowMs()
-  local order = {}
-  for i, voxel in ipairs(model) do
-    local t = rotation.transformVoxel(voxel, {
-      middlePoint = middlePoint,
-      xRotation = params.xRotation,
-      yRotation = params.yRotation,
-      zRotation = params.zRotation
-    })
-    local vcx = t.x + 0.5
-    local vcy = t.y + 0.5
-    local vcz = t.z + 0.5
-    local dx = vcx - cameraPos.x
-    local dy = vcy - cameraPos.y
-    local dz = vcz - cameraPos.z
-    order[#order+1] = {
-      voxel = voxel,
-      transformed = t,
-      depth = dx*dx + dy*dy + dz*dz,
-      hiddenFaces = optimized[i].hiddenFaces or {}
-    }
+  -- Lua heap allocated from here through the draw loop (metrics.drawAllocKB):
+  -- net of any collection step in the window, exact when profiling
+  local _exactAlloc = _metrics and enableProfiling and collectgarbage("isrunning")
+  local _gcHold <close> = _exactAlloc and _gcGuard or nil
+  if _exactAlloc then
+    collectgarbage("stop")
+    _gcStopped = true
+  end
+  local _kb_start = _metrics and collectgarbage("count")
+  -- Draw list: slots in the shared arrays, filled straight from the brick
+  -- surfaces (no voxel tables, no per-frame closures)
+  local order = _order
+  local TX, TY, TZ, VX, VY, VZ = _tx, _ty, _tz, _vx, _vy, _vz
+  local RGBA, HIDDEN, DEPTH = _rgba, _hidden, _depth
+  _mpx, _mpy, _mpz = middlePoint.x, middlePoint.y, middlePoint.z
+  _camX, _camY, _camZ = cameraPos.x, cameraPos.y, cameraPos.z
+  local rxRad, ryRad, rzRad = math.rad(params.xRotation), math.rad(params.yRotation), math.rad(params.zRotation)
+  _rcx, _rsx = math.cos(rxRad), math.sin(rxRad)
+  _rcy, _rsy = math.cos(ryRad), math.sin(ryRad)
+  _rcz, _rsz = math.cos(rzRad), math.sin(rzRad)
+  _slots = 0
+  if grid then
+    -- Whole-brick viewport test, then only surface voxels of surviving bricks.
+    -- DirectCanvas projects with the pan (offsetX/Y) and zoom already applied,
+    -- so the context rect is the on-screen view; offscreen frames are culled
+    -- to the image, which the dialog re-blits when panning.
+    local view = _cullView
+    view.middlePoint = middlePoint
+    view.xRotation, view.yRotation, view.zRotation = params.xRotation, params.yRotation, params.zRotation
+    view.voxelSize, view.centerX, view.centerY, view.camera = voxelSize, centerX, centerY, camera
+    view.minX, view.minY = 0, 0
+    view.maxX = isDirectCanvas and target.width or width
+    view.maxY = isDirectCanvas and target.height or height
+    local visible, culled = brickCache.cullBricks(grid, view, _visibleBricks)
+    local cellXYZ = brickCache.cellXYZ
+    for _, brick in ipairs(visible) do
+      local surface, masks, occ = brick.surface, brick.surfaceMask, brick.occ
+      for k = 1, #surface do
+        local c = surface[k]
+        local vx, vy, vz = cellXYZ(brick, c)
+        _pushSlot(vx, vy, vz, occ[c], masks[k])
+      end
+    end
+    if _metrics then
+      _metrics.bricksCulled = culled
+      _metrics.shellVoxels = grid.shellCount
+    end
+  else
+    local packColor = AseVoxel.render.voxel_buffer.packColor
+    for i, voxel in ipairs(model) do
+      _pushSlot(voxel.x, voxel.y, voxel.z, packColor(voxel.color), faceMask(optimized[i].hiddenFaces))
+    end
+  end
+  local n = _slots
+  for i = 1, #_visibleBricks do _visibleBricks[i] = nil end
+  _cullView.middlePoint, _cullView.camera = nil, nil
+  -- The coherent sorter owns its permutation; order is a copy the OIT
+  -- split may reorder
+  local perm
+  if depthSort then
+    _drawOrder = _drawOrder or depthSort.newCoherent()
+    local sortBackend
+    perm, sortBackend = depthSort.orderCoherent(_drawOrder, DEPTH, n, grid and grid.fingerprint or model, params)
+    if _metrics then _metrics.sortBackend = sortBackend end
+  end
+  for i = 1, n do order[i] = perm and perm[i] or i end
+  for i = #order, n + 1, -1 do order[i] = nil end
+  if not perm then
+    table.sort(order, _fartherSlot)
   end
-  table.sort(order, function(a,b) return a.depth > b.depth end)
   if _metrics then _metrics.t_transformSort_ms = _nowMs() - _t_sort_start end
   if enableProfiling and profiler then profiler.measure("transform_and_sort") end
 
@@ -1532,63 +1753,76 @@ function previewRenderer.renderPreview(model, params)
   -- Main voxel draw loop
   if enableProfiling and profiler then profiler.mark("draw_loop") end
   local _t_draw_start = _nowMs()
+  _overdraw = (params.overdraw and overdraw and _metrics and not isDirectCanvas)
+    and overdraw.begin(width, height) or nil
   
   -- NEW: Get precomputed visible faces (same for ALL voxels!)
-  local globalVisibleFaces = fastVisibility and fastVisibility.getVisibleFaces() or nil
-  
-  for _, item in ipairs(order) do
-    local v = item.voxel
-    local tv = item.transformed
+  local globalMask = fastVisibility and fastVisibility.getVisibleMask() or nil
+
+  -- Translucent models: opaque voxels first (they fill the per-pixel depth),
+  -- translucent ones after, accumulated order-independently and resolved
+  -- once. params.transparency = "painter" keeps the plain sorted overwrite.
+  params._oit = nil
+  if oit and grid and grid.translucent and not isDirectCanvas and params.transparency ~= "painter" then
+    params._oit = oit.begin(width, height, cameraDistance - (params._modelRadiusApprox or maxDimension))
+    -- Stable in-place split: opaque entries first, translucent after
+    local glass, no, ng = _glass, 0, 0
+    for i = 1, n do
+      local slot = order[i]
+      if (RGBA[slot] & 0xFF) < 255 then
+        ng = ng + 1
+        glass[ng] = slot
+      else
+        no = no + 1
+        order[no] = slot
+      end
+    end
+    for i = 1, ng do
+      order[no + i] = glass[i]
+      glass[i] = nil
+    end
+    if _metrics then _metrics.oitVoxels = ng end
+  end
+
+  beginShadeFrame(params)
+  prepareFaceNormals(params)
+  local visParams = _visParams
+  visParams.xRotation, visParams.yRotation, visParams.zRotation = params.xRotation, params.yRotation, params.zRotation
+  visParams.voxelSize = voxelSize
+
+  for i = 1, n do
+    local slot = order[i]
+    local tv = _tv
+    tv.x, tv.y, tv.z = TX[slot], TY[slot], TZ[slot]
     
     -- NEW: Use precomputed visibility instead of per-voxel calculation!
-    local faceVis
-    if globalVisibleFaces then
-      -- Fast path: use precomputed global visibility
-      faceVis = {}
-      for faceName, visible in pairs(globalVisibleFaces) do
-        faceVis[faceName] = visible
-      end
-    else
+    local faceVis = globalMask
+    if not faceVis then
       -- Fallback: per-voxel calculation (old way)
-      local faceVisRaw = previewRenderer.calculateFaceVisibility(tv, cameraPos, params.orthogonal, {
-        xRotation = params.xRotation,
-        yRotation = params.yRotation,
-        zRotation = params.zRotation,
-        voxelSize = voxelSize
-      })
-      faceVis = {front=false,back=false,right=false,left=false,top=false,bottom=false}
-      for fname, vis in pairs(faceVisRaw) do faceVis[fname] = vis end
+      faceVis = faceMask(previewRenderer.calculateFaceVisibility(tv, cameraPos, params.orthogonal, visParams))
     end
     
     -- Apply adjacency culling (only to visible faces!)
-    for faceName, hidden in pairs(item.hiddenFaces) do
-      if hidden then
-        faceVis[faceName] = false
-        if _metrics then _metrics.facesCulledAdj = _metrics.facesCulledAdj + 1 end
-      end
-    end
+    local culled = faceVis & HIDDEN[slot]
+    local culledAdj = POPCOUNT[culled]
+    faceVis = faceVis ~ culled
     
-    -- Count backfaces for metrics (only if metrics enabled)
+    -- Face counters: each of the 6 faces is drawn, adjacency-culled or back-facing
     if _metrics then
-      local drawCount = 0
-      for fname, vis in pairs(faceVis) do 
-        if vis then 
-          drawCount = drawCount + 1 
-        else
-          _metrics.facesBackfaced = _metrics.facesBackfaced + 1
-        end
-      end
+      local drawCount = POPCOUNT[faceVis]
       _metrics.facesDrawn = _metrics.facesDrawn + drawCount
       _metrics.polygonsFilled = _metrics.polygonsFilled + drawCount
+      _metrics.facesCulledAdj = _metrics.facesCulledAdj + culledAdj
+      _metrics.facesBackfaced = _metrics.facesBackfaced + (6 - drawCount - culledAdj)
     end
 
     -- Dynamic per-voxel: radial attenuation & simple shadow placeholder
     if params.shadingMode == "Dynamic" and params.lighting and params.lighting._cache then
       local cache = params.lighting._cache
       -- Compute perpendicular distance from voxel to the light axis (axis passes through model center)
-      local vx = v.x - cache.modelCenter.x
-      local vy = v.y - cache.modelCenter.y
-      local vz = v.z - cache.modelCenter.z
+      local vx = VX[slot] - cache.modelCenter.x
+      local vy = VY[slot] - cache.modelCenter.y
+      local vz = VZ[slot] - cache.modelCenter.z
       local ax, ay, az = cache.axis.x, cache.axis.y, cache.axis.z
       -- projection length along axis
       local proj = vx*ax + vy*ay + vz*az
@@ -1619,16 +1853,31 @@ function previewRenderer.renderPreview(model, params)
 
     local sx = centerX + (tv.x - middlePoint.x) * voxelSize
     local sy = centerY + (tv.y - middlePoint.y) * voxelSize
-    -- Count faces to be drawn for metrics
-    if _metrics then
-      local drawCount = 0
-      for fname, vis in pairs(faceVis) do if vis then drawCount = drawCount + 1 end end
-      _metrics.facesDrawn = _metrics.facesDrawn + drawCount
-      _metrics.polygonsFilled = _metrics.polygonsFilled + drawCount
-    end
-    previewRenderer.drawVoxel(target, sx, sy, voxelSize, v.color, faceVis, params, tv, middlePoint, camera)
+    previewRenderer.drawVoxel(target, sx, sy, voxelSize, RGBA[slot], faceVis, params, tv, middlePoint, camera)
+  end
+  if params._oit then
+    oit.resolve(params._oit, target)
+    params._oit = nil
+  end
+  if _metrics then
+    _metrics.t_draw_ms = _nowMs() - _t_draw_start
+    _metrics.drawAllocKB = math.max(0, collectgarbage("count") - _kb_start)
+    if _gcStopped then
+      collectgarbage("restart")
+      _gcStopped = false
+    end
+  end
+  -- Overdraw instrumentation: summary counters + heatmap at output size
+  if _overdraw then
+    local od = overdraw.finish(_overdraw)
+    _metrics.pixelsWritten = od.pixelsWritten
+    _metrics.pixelsCovered = od.pixelsCovered
+    _metrics.wastedWrites = od.wastedWrites
+    _metrics.overdraw = od.depthComplexity
+    _metrics.overdrawStats = od
+    _metrics.overdrawImage = overdraw.heatmap(_overdraw, ss)
+    _overdraw = nil
   end
-  if _metrics then _metrics.t_draw_ms = _nowMs() - _t_draw_start end
   if enableProfiling and profiler then profiler.measure("draw_loop") end
 
   -- Post-processing only applies to OffscreenImage mode
@@ -1666,11 +1915,328 @@ function previewRenderer.renderPreview(model, params)
 end
 
 --------------------------------------------------------------------------------
--- Wrapper: renderVoxelModel (handles remote first)
+-- Native request packaging (shared by the blocking and job paths)
+--------------------------------------------------------------------------------
+local NATIVE_BACKENDS = { basic = "native-basic", stack = "native-stack", dynamic = "native-dynamic" }
+
+-- Returns flat voxels, native params and the render kind (basic/stack/dynamic)
+local function _buildNativeRequest(model, params, _metrics)
+  local xRot = params.x or params.xRotation or 0
+  local yRot = params.y or params.yRotation or 0
+  local zRot = params.z or params.zRotation or 0
+  local scale = params.scale or params.scaleLevel or 1.0
+  -- Opaque models only need their shell: interior faces would be painted
+  -- over anyway. Translucent models keep every voxel so blending is unchanged.
+  local source = model
+  local shell = brickCache and brickCache.getShell(model)
+  if shell and not shell.translucent then
+    source = shell
+  end
+  if _metrics then
+    _metrics.voxels = #model
+    _metrics.shellVoxels = shell and shell.count or nil
+  end
+  -- The shell is itself a voxel buffer. The native module takes one
+  -- {x,y,z,r,g,b,a} array per voxel, flattened once per buffer and reused
+  -- by every later frame.
+  local vb = AseVoxel.render.voxel_buffer
+  local flat = vb.nativeVoxels(vb.of(source))
+  local bg = params.backgroundColor
+  local nativeParams = {
+    width  = params.width or 200,
+    height = params.height or 200,
+    xRotation = xRot, yRotation = yRot, zRotation = zRot,
+    scale = scale,
+    orthogonal = params.orthogonal or params.orthogonalView or false,
+    basicShadeIntensity = params.basicShadeIntensity or 50,
+    basicLightIntensity = params.basicLightIntensity or 50,
+    fovDegrees = params.fovDegrees or params.fov,
+    perspectiveScaleRef = params.perspectiveScaleRef or "middle",
+    backgroundColor = bg and {
+      r = bg.red or bg.r, g = bg.green or bg.g, b = bg.blue or bg.b, a = bg.alpha or bg.a
+    } or {r=0,g=0,b=0,a=0}
+  }
+  -- Translucent models: ask for order-independent compositing ("weighted"
+  -- blended, or "fragments" for exact per-pixel lists); builds that predate
+  -- the field ignore it and keep their sorted blend.
+  if shell and shell.translucent then
+    nativeParams.transparency = params.transparency or "weighted"
+  end
+  -- Dynamic lighting param packaging (only when needed)
+  if params.shadingMode == "Dynamic" and params.lighting then
+    local lc = params.lighting.lightColor or Color(255,255,255)
+    nativeParams.lighting = {
+      pitch      = params.lighting.pitch or 0,
+      yaw        = params.lighting.yaw or 0,
+      diffuse    = params.lighting.diffuse or 60,
+      diameter   = params.lighting.diameter or 100,
+      ambient    = params.lighting.ambient or 30,
+      rimEnabled = params.lighting.rimEnabled and true or false,
+      lightColor = {
+        r = lc.red or lc.r or 255,
+        g = lc.green or lc.g or 255,
+        b = lc.blue or lc.b or 255
+      }
+    }
+  end
+  local kind = "basic"
+  if params.shadingMode == "Stack" and nativeBridge.renderStack then
+    kind = "stack"
+    nativeParams.fxStack = params.fxStack
+  elseif params.shadingMode == "Dynamic" and nativeBridge.renderDynamic then
+    kind = "dynamic"
+  end
+  return flat, nativeParams, kind
+end
+
+-- Converts a native { width, height, pixels } result into an Image
+local function _nativeResultToImage(nativeResult)
+  local w = nativeResult.width
+  local h = nativeResult.height
+  local bytes = nativeResult.pixels
+  local expected = w * h * 4
+  if #bytes ~= expected then
+    print("[asevoxel-native] native buffer mismatch (fallback)")
+    return nil
+  end
+  local img = Image(w, h, ColorMode.RGB)
+  local idx = 1
+  for y=0,h-1 do
+    for x=0,w-1 do
+      local r = string.byte(bytes, idx    )
+      local g = string.byte(bytes, idx + 1)
+      local b = string.byte(bytes, idx + 2)
+      local a = string.byte(bytes, idx + 3)
+      idx = idx + 4
+      img:putPixel(x, y, app.pixelColor.rgba(r,g,b,a))
+    end
+  end
+  return img
+end
+
+-- Native per-stage timings/counters (native_bridge: result.metrics) become
+-- profiler sections "native_<stage>" and the same _metrics keys the Lua path
+-- fills, so the Debug tab and the adaptive governor read both backends alike.
+local NATIVE_STAGES = { "parse", "transform", "cull", "raster", "shade", "outline", "downsample" }
+
+-- startMs (profiler clock, when known) places the stages back to back on the
+-- trace's native track; otherwise they are laid out to end now.
+local function _mergeNativeMetrics(nativeResult, _metrics, enableProfiling, startMs)
+  local nm = nativeResult and nativeResult.metrics
+  if type(nm) ~= "table" then return end
+  if enableProfiling and profiler and profiler.record then
+    local cursor = startMs
+    if not cursor then
+      cursor = profiler.now()
+      for _, stage in ipairs(NATIVE_STAGES) do cursor = cursor - (tonumber(nm[stage .. "_ms"]) or 0) end
+    end
+    for _, stage in ipairs(NATIVE_STAGES) do
+      local ms = nm[stage .. "_ms"]
+      profiler.record("native_" .. stage, ms, cursor, "native")
+      cursor = cursor + (tonumber(ms) or 0)
+    end
+  end
+  if not _metrics then return end
+  local function ms(stage) return tonumber(nm[stage .. "_ms"]) or 0 end
+  for _, stage in ipairs(NATIVE_STAGES) do
+    _metrics["t_native_" .. stage .. "_ms"] = nm[stage .. "_ms"]
+  end
+  _metrics.t_transformSort_ms = ms("parse") + ms("transform") + ms("cull")
+  _metrics.t_draw_ms = ms("raster") + ms("shade")
+  _metrics.t_outline_ms = nm.outline_ms
+  _metrics.t_downsample_ms = nm.downsample_ms
+  _metrics.facesDrawn = nm.faces_drawn
+  _metrics.polygonsFilled = nm.faces_drawn
+  _metrics.pixelsWritten = nm.pixels_written
+  _metrics.overdraw = nm.overdraw
+  _metrics.nativeAllocs = nm.alloc_count
+  _metrics.nativeAllocBytes = nm.alloc_bytes
+end
+
+--------------------------------------------------------------------------------
+-- Frame cache key: model content fingerprint + canonical render params.
+-- nil when caching is unavailable or opted out (params.noFrameCache). The
+-- rotation is exact unless params.cacheQuantized (interactive preview).
+--------------------------------------------------------------------------------
+function previewRenderer.frameKey(model, params)
+  _initModules()
+  if not (frameCache and brickCache) or params.noFrameCache or params.overdraw then return nil end
+  if not model or #model == 0 then return nil end
+  local grid = brickCache.update(model)
+  if not grid then return nil end
+  return frameCache.makeKey(grid.fingerprint, grid.voxelCount, params)
+end
+
 --------------------------------------------------------------------------------
+-- Background native render
+-- Returns a job with job:poll() ("running"/"done"/"cancelled"/"failed"),
+-- job:cancel() and job:result() (the Image), or nil when the native module
+-- has no job API; callers then render synchronously with renderVoxelModel.
+--------------------------------------------------------------------------------
+-- Backends read params.scale; viewer params only carry scaleLevel. Fill it in
+-- on a copy so the caller's table is left as given (frame keys fold the two).
+local function _withScale(params)
+  if params.scale then return params end
+  local p = {}
+  for k, v in pairs(params) do p[k] = v end
+  p.scale = params.scaleLevel or 1.0
+  return p
+end
+
+function previewRenderer.submitVoxelModel(model, params)
+  _initModules()
+  params = params or {}
+  if not (nativeBridge_ok and nativeBridge and nativeBridge.isAvailable()
+          and nativeBridge.supportsAsync()) then
+    return nil
+  end
+  local rr = _getRemote()
+  if rr and rr.isEnabled and rr.isEnabled() then return nil end
+  if not model or #model == 0 or params.overdraw then return nil end
+
+  local _metrics = params.metrics
+  local key = previewRenderer.frameKey(model, params)
+  local hit = key and frameCache.get(key)
+  if hit then
+    if _metrics then _metrics.backend = "frame-cache" end
+    return {
+      poll = function(self) return "done" end,
+      cancel = function(self) end,
+      result = function(self) return hit end
+    }
+  end
+  params = _withScale(params)
+  local flat, nativeParams, kind = _buildNativeRequest(model, params, _metrics)
+  local job = nativeBridge.submitRender(kind, flat, nativeParams)
+  if not job then return nil end
+  -- A finished job whose buffer does not decode counts as a worker failure
+  -- (decodeFailed; poll() reports "failed" from then on)
+  return {
+    poll = function(self)
+      if self.decodeFailed then return "failed" end
+      return job:poll()
+    end,
+    cancel = function(self) job:cancel() end,
+    result = function(self)
+      local res = job:result()
+      local img = res and _nativeResultToImage(res)
+      if img then
+        _mergeNativeMetrics(res, _metrics, params.enableProfiling)
+        if _metrics then _metrics.backend = NATIVE_BACKENDS[kind] end
+        if key then frameCache.put(key, img) end
+      elseif res then
+        self.decodeFailed = true
+      end
+      return img
+    end
+  }
+end
+
+--------------------------------------------------------------------------------
+-- Batch render: one model, many views (turntables, direction sheets).
+-- views: array of { xRotation, yRotation, zRotation [, matrix] }; params holds
+-- everything the views share. Returns an array of Images in view order.
+-- The native module renders all uncached views in one call across its worker
+-- threads; otherwise views go through renderVoxelModel one by one, where the
+-- shared model keeps brick_cache (grid, shell) warm after the first view.
+--------------------------------------------------------------------------------
+function previewRenderer.renderVoxelModelBatch(model, params, views)
+  _initModules()
+  params = params or {}
+  local images = {}
+  if not model or #model == 0 or not views or #views == 0 then return images end
+
+  local function viewParams(v)
+    local p = {}
+    for k, val in pairs(params) do p[k] = val end
+    p.x, p.y, p.z = nil, nil, nil
+    p.cacheQuantized = nil   -- batch frames must be the exact view
+    p.xRotation = v.xRotation or v.x or 0
+    p.yRotation = v.yRotation or v.y or 0
+    p.zRotation = v.zRotation or v.z or 0
+    return p
+  end
+
+  -- Cached views first; the rest are batched
+  local todo, todoKeys = {}, {}
+  for i, v in ipairs(views) do
+    local p = viewParams(v)
+    local key = previewRenderer.frameKey(model, p)
+    local hit = key and frameCache.get(key)
+    if hit then
+      images[i] = hit
+    else
+      todo[#todo + 1] = i
+      todoKeys[i] = key
+    end
+  end
+  if #todo == 0 then return images end
+
+  local rr = _getRemote()
+  local remote = rr and rr.isEnabled and rr.isEnabled()
+  if not remote and nativeBridge_ok and nativeBridge and nativeBridge.isAvailable()
+     and nativeBridge.renderBatch then
+    local base = {}
+    for k, val in pairs(params) do base[k] = val end
+    base.scale = base.scale or base.scaleLevel or 1.0
+    local flat, nativeParams, kind = _buildNativeRequest(model, base, params.metrics)
+    local nviews = {}
+    for j, i in ipairs(todo) do
+      local v = views[i]
+      nviews[j] = {
+        xRotation = v.xRotation or v.x or 0,
+        yRotation = v.yRotation or v.y or 0,
+        zRotation = v.zRotation or v.z or 0,
+        matrix = v.matrix
+      }
+    end
+    local results = nativeBridge.renderBatch(kind, flat, nativeParams, nviews)
+    if results then
+      for j, i in ipairs(todo) do
+        local img = _nativeResultToImage(results[j])
+        if img then
+          _mergeNativeMetrics(results[j], params.metrics, params.enableProfiling)
+          images[i] = img
+          if todoKeys[i] then frameCache.put(todoKeys[i], img) end
+        end
+      end
+      if params.metrics then params.metrics.backend = NATIVE_BACKENDS[kind] .. "-batch" end
+    end
+  end
+
+  -- Anything still missing (no batch API, failed conversion): per view
+  for _, i in ipairs(todo) do
+    if not images[i] then
+      images[i] = previewRenderer.renderVoxelModel(model, viewParams(views[i]))
+    end
+  end
+  return images
+end
+
+--------------------------------------------------------------------------------
+-- Wrapper: renderVoxelModel (frame cache, then remote/native/Lua backends)
+-- A cache hit returns the shared cached Image: callers must not draw into it.
+--------------------------------------------------------------------------------
+local _renderVoxelModelUncached
+
 function previewRenderer.renderVoxelModel(model, params)
   _initModules()  -- Initialize lazy-loaded modules
   params = params or {}
+  -- Key before any backend touches params
+  local key = previewRenderer.frameKey(model, params)
+  if key then
+    local hit = frameCache.get(key)
+    if hit then
+      if params.metrics then params.metrics.backend = "frame-cache" end
+      return hit
+    end
+  end
+  local img = _renderVoxelModelUncached(model, params)
+  if key and img then frameCache.put(key, img) end
+  return img
+end
+
+_renderVoxelModelUncached = function(model, params)
   local _metrics = params.metrics
   
   -- NEW: Start profiling at top level (covers all render paths)
@@ -1683,8 +2249,8 @@ function previewRenderer.renderVoxelModel(model, params)
   local xRot = params.x or params.xRotation or 0
   local yRot = params.y or params.yRotation or 0
   local zRot = params.z or params.zRotation or 0
-  local scale = params.scale or params.scaleLevel or 1.0
-  params.scale = scale
+  params = _withScale(params)
+  local scale = params.scale
 
   -- Native renderer fast-path (Basic / Stack / Dynamic)
   local canNativeNative = nativeBridge_ok
@@ -1695,146 +2261,56 @@ function previewRenderer.renderVoxelModel(model, params)
   if rr and rr.isEnabled and rr.isEnabled() then
     canNativeNative = false
   end
+  -- Overdraw counting happens in the Lua rasterizer (same coverage rule)
+  local remoteOk = rr and rr.isEnabled and rr.isEnabled()
+  if params.overdraw then
+    canNativeNative, remoteOk = false, false
+  end
 
   if canNativeNative and model and #model > 0 then
-    local flat = {}
-    for i,v in ipairs(model) do
-      local c = v.color or {}
-      flat[i] = {
-        v.x or 0, v.y or 0, v.z or 0,
-        math.max(0, math.min(255, c.r or c.red or 255)),
-        math.max(0, math.min(255, c.g or c.green or 255)),
-        math.max(0, math.min(255, c.b or c.blue or 255)),
-        math.max(0, math.min(255, c.a or c.alpha or 255))
-      }
-    end
-    local bg = params.backgroundColor
-    local nativeParams = {
-      width  = params.width or 200,
-      height = params.height or 200,
-      xRotation = xRot, yRotation = yRot, zRotation = zRot,
-      scale = scale,
-      orthogonal = params.orthogonal or params.orthogonalView or false,
-      basicShadeIntensity = params.basicShadeIntensity or 50,
-      basicLightIntensity = params.basicLightIntensity or 50,
-      fovDegrees = params.fovDegrees or params.fov,
-      perspectiveScaleRef = params.perspectiveScaleRef or "middle",
-      backgroundColor = bg and {
-        r = bg.red or bg.r, g = bg.green or bg.g, b = bg.blue or bg.b, a = bg.alpha or bg.a
-      } or {r=0,g=0,b=0,a=0}
-    }
-    -- Dynamic lighting param packaging (only when needed)
-    if params.shadingMode == "Dynamic" and params.lighting then
-      local lc = params.lighting.lightColor or Color(255,255,255)
-      nativeParams.lighting = {
-        pitch      = params.lighting.pitch or 0,
-        yaw        = params.lighting.yaw or 0,
-        diffuse    = params.lighting.diffuse or 60,
-        diameter   = params.lighting.diameter or 100,
-        ambient    = params.lighting.ambient or 30,
-        rimEnabled = params.lighting.rimEnabled and true or false,
-        lightColor = {
-          r = lc.red or lc.r or 255,
-          g = lc.green or lc.g or 255,
-          b = lc.blue or lc.b or 255
-        }
-      }
-    end
-    local nativeResult
-    
-    -- Profile native rendering
     if enableProfiling and profiler then
       profiler.mark("native_flatten_and_setup")
     end
-    
-    if params.shadingMode == "Stack" and nativeBridge.renderStack then
-      nativeParams.fxStack = params.fxStack
-      if enableProfiling and profiler then
-        profiler.measure("native_flatten_and_setup")
-        profiler.mark("native_render_stack")
-      end
+    local flat, nativeParams, kind = _buildNativeRequest(model, params, _metrics)
+    if enableProfiling and profiler then
+      profiler.measure("native_flatten_and_setup")
+      profiler.mark("native_render_" .. kind)
+    end
+
+    local nativeStart = enableProfiling and profiler and profiler.now()
+    local nativeResult
+    if kind == "stack" then
       nativeResult = nativeBridge.renderStack(flat, nativeParams)
-      if enableProfiling and profiler then
-        profiler.measure("native_render_stack")
-      end
-    elseif params.shadingMode == "Dynamic" and nativeBridge.renderDynamic then
-      if enableProfiling and profiler then
-        profiler.measure("native_flatten_and_setup")
-        profiler.mark("native_render_dynamic")
-      end
+    elseif kind == "dynamic" then
       nativeResult = nativeBridge.renderDynamic(flat, nativeParams)
-      if enableProfiling and profiler then
-        profiler.measure("native_render_dynamic")
-      end
     else
-      if enableProfiling and profiler then
-        profiler.measure("native_flatten_and_setup")
-        profiler.mark("native_render_basic")
-      end
       nativeResult = nativeBridge.renderBasic(flat, nativeParams)
-      if enableProfiling and profiler then
-        profiler.measure("native_render_basic")
-      end
     end
-    
     if enableProfiling and profiler then
+      profiler.measure("native_render_" .. kind)
       profiler.mark("native_pixel_conversion")
     end
-    
-    if nativeResult and nativeResult.pixels then
-      local w = nativeResult.width
-      local h = nativeResult.height
-      local bytes = nativeResult.pixels
-      local expected = w * h * 4
-      if #bytes == expected then
-        local img = Image(w, h, ColorMode.RGB)
-        local idx = 1
-        for y=0,h-1 do
-          for x=0,w-1 do
-            local r = string.byte(bytes, idx    )
-            local g = string.byte(bytes, idx + 1)
-            local b = string.byte(bytes, idx + 2)
-            local a = string.byte(bytes, idx + 3)
-            idx = idx + 4
-            img:putPixel(x, y, app.pixelColor.rgba(r,g,b,a))
-          end
-        end
-        
-        if enableProfiling and profiler then
-          profiler.measure("native_pixel_conversion")
-          profiler.measure("total")
-        end
-        
-        if _metrics then
-          if params.shadingMode=="Stack" then
-            _metrics.backend = "native-stack"
-          elseif params.shadingMode=="Dynamic" then
-            _metrics.backend = "native-dynamic"
-          else
-            _metrics.backend = "native-basic"
-          end
-         end
-        return img
-      else
-        print("[asevoxel-native] native buffer mismatch (fallback)")
+
+    local img = nativeResult and nativeResult.pixels and _nativeResultToImage(nativeResult)
+    if img then
+      if enableProfiling and profiler then
+        profiler.measure("native_pixel_conversion")
+      end
+      _mergeNativeMetrics(nativeResult, _metrics, enableProfiling, nativeStart or nil)
+      if enableProfiling and profiler then
+        profiler.measure("total")
       end
+      if _metrics then _metrics.backend = NATIVE_BACKENDS[kind] end
+      return img
     end
   end
 
   -- (remote path retained)
-  if rr and rr.isEnabled and rr.isEnabled() then
+  if remoteOk then
     if _metrics then _metrics.backend = "remote" end
     -- NOTE: FX Stack NOT applied remotely yet.
-    local voxelsFlat = {}
-    for _, v in ipairs(model) do
-      voxelsFlat[#voxelsFlat+1] = {
-        v.x, v.y, v.z,
-        math.max(0, math.min(255, v.color.r or 0)),
-        math.max(0, math.min(255, v.color.g or 0)),
-        math.max(0, math.min(255, v.color.b or 0)),
-        math.max(0, math.min(255, v.color.a or 255))
-      }
-    end
+    local vb = AseVoxel.render.voxel_buffer
+    local voxelsFlat = vb.nativeVoxels(vb.of(model))
     local lightingGrid = {}
     for i=1,27 do lightingGrid[i]=0 end
     lightingGrid[2*9 + 1*3 + 1 + 1] = 1
@@ -1896,7 +2372,10 @@ function previewRenderer.renderVoxelModel(model, params)
     perspectiveScaleRef = params.perspectiveScaleRef or "middle",
     fxStack = params.fxStack,
     shadingMode = params.shadingMode or "Stack",
+    overdraw = params.overdraw,
     lighting = params.lighting,
+    transparency = params.transparency,
+    maxSupersample = params.maxSupersample,
     metrics = _metrics,
     enableProfiling = enableProfiling,  -- NEW: Pass profiling flag to renderPreview
   })
@@ -2025,6 +2504,25 @@ function previewRenderer.downsampleInteger(src, factor, mode)
   return dst
 end
 
+-- Nearest-neighbor integer upscale (reduced-resolution interactive frames)
+function previewRenderer.upscaleInteger(src, factor)
+  if factor <= 1 then return src end
+  local dst = Image(src.width * factor, src.height * factor, src.colorMode)
+  for sy = 0, src.height - 1 do
+    local oy0 = sy * factor
+    for sx = 0, src.width - 1 do
+      local c = src:getPixel(sx, sy)
+      local ox0 = sx * factor
+      for ky = 0, factor - 1 do
+        for kx = 0, factor - 1 do
+          dst:putPixel(ox0 + kx, oy0 + ky, c)
+        end
+      end
+    end
+  end
+  return dst
+end
+
 --------------------------------------------------------------------------------
 -- OBJ Export (Y-flip version)
 --------------------------------------------------------------------------------
@@ -0,0 +1,264 @@
+-- timeline_cache.lua
+-- Per-frame voxel models for the sprite timeline. Each visible layer's cel is
+-- voxelized once per distinct content (linked cels and unchanged images share
+-- one slice), and frames whose slices all match share one model table, so
+-- brick_cache grids and frame_cache entries stay valid across frame changes.
+-- Cel content is identified by a hash of Image.bytes (plus position); builds
+-- without it fall back to Image.id/version, and without either nothing is
+-- cached: such frames are rebuilt on every call and counted as "uncached"
+-- (Debug tab, Timeline cache line).
+-- Slices are kept packed (voxel_buffer); each model is a view over the
+-- concatenated buffer, attached so voxelBuffer.of(model) costs nothing.
+
+local timelineCache = {}
+
+timelineCache.enabled = true
+timelineCache.MAX_FRAMES = 256
+
+local _sprite = nil
+local _frames = {}     -- frameNumber -> { sig, model, slices = {sliceKey...} }
+local _frameCount = 0
+local _models = {}     -- frame signature -> model (frames with equal content)
+local _slices = {}     -- sliceKey -> VoxelBuffer for one layer cel
+local _contentIds = {} -- content digest -> { [posKey] = id }
+local _nextId = 0
+local _stats = { hits = 0, builds = 0, sliceHits = 0, sliceBuilds = 0, uncached = 0 }
+
+--------------------------------------------------------------------------------
+-- Cel identity
+--------------------------------------------------------------------------------
+-- Two independent 64-bit hashes of the pixel bytes plus their length, so the
+-- key is a short string instead of a second copy of every cel's pixels
+local WORDS = string.rep("i8", 8)
+local function bytesDigest(bytes)
+  local n = #bytes
+  local h1, h2 = -3750763034362895579, n   -- FNV-1a offset basis
+  local unpack = string.unpack
+  local i = 1
+  while i + 63 <= n do
+    local w1, w2, w3, w4, w5, w6, w7, w8 = unpack(WORDS, bytes, i)
+    h1 = (((((((((h1 ~ w1) * 1099511628211 ~ w2) * 1099511628211 ~ w3) * 1099511628211
+      ~ w4) * 1099511628211 ~ w5) * 1099511628211 ~ w6) * 1099511628211 ~ w7)
+      * 1099511628211 ~ w8) * 1099511628211)
+    h2 = (h2 + w1 * 3 + w2 * 5 + w3 * 7 + w4 * 11 + w5 * 13 + w6 * 17 + w7 * 19 + w8 * 23)
+      * -7046029254386353131
+    h2 = h2 ~ (h2 >> 31)
+    i = i + 64
+  end
+  for k = i, n do
+    local b = bytes:byte(k)
+    h1 = (h1 ~ b) * 1099511628211
+    h2 = (h2 + b) * -7046029254386353131
+  end
+  return string.format("%x:%x:%d", h1, h2, n)
+end
+
+-- Content id for a cel (same image + position -> same id), or nil
+local function celContentId(cel)
+  local image = cel.image
+  local pos = cel.position
+  local posKey = pos.x .. "," .. pos.y .. ":" .. image.width .. "x" .. image.height
+  local okB, bytes = pcall(function() return image.bytes end)
+  local content
+  if okB and type(bytes) == "string" then
+    content = bytesDigest(bytes)
+  else
+    local okV, sig = pcall(function() return "i" .. image.id .. "v" .. image.version end)
+    if not okV then return nil end
+    content = sig
+  end
+  local byPos = _contentIds[content]
+  if not byPos then
+    byPos = {}
+    _contentIds[content] = byPos
+  end
+  local id = byPos[posKey]
+  if not id then
+    _nextId = _nextId + 1
+    id = _nextId
+    byPos[posKey] = id
+  end
+  return id
+end
+
+local function getVoxelBuffer()
+  return AseVoxel.render.voxel_buffer
+end
+
+--------------------------------------------------------------------------------
+-- Voxelization (same voxels as voxelGenerator's standard path)
+--------------------------------------------------------------------------------
+local function voxelizeCel(cel, z, buf)
+  local pc = app.pixelColor
+  local vb = getVoxelBuffer()
+  local pack, push = vb.pack, vb.push
+  local image = cel.image
+  local ox, oy = cel.position.x, cel.position.y
+  for y = 0, image.height - 1 do
+    for x = 0, image.width - 1 do
+      local px = image:getPixel(x, y)
+      local a = pc.rgbaA(px)
+      if a > 0 then
+        push(buf, x + ox, y + oy, z, pack(pc.rgbaR(px), pc.rgbaG(px), pc.rgbaB(px), a))
+      end
+    end
+  end
+  return buf
+end
+
+local function visibleLayers(sprite)
+  local layers = {}
+  for _, layer in ipairs(sprite.layers) do
+    if not layer.isGroup and layer.isVisible then layers[#layers + 1] = layer end
+  end
+  return layers
+end
+
+-- Uncached build (no content identity available)
+local function buildDirect(layers, frameNumber)
+  local vb = getVoxelBuffer()
+  local buf = vb.new()
+  for z, layer in ipairs(layers) do
+    local cel = layer:cel(frameNumber)
+    if cel and cel.image then voxelizeCel(cel, z, buf) end
+  end
+  return vb.model(buf)
+end
+
+--------------------------------------------------------------------------------
+-- Eviction: drop slices/content no retained frame refers to
+--------------------------------------------------------------------------------
+local function sweep()
+  local liveSlices, liveModels = {}, {}
+  for _, e in pairs(_frames) do
+    liveModels[e.sig] = true
+    for _, k in ipairs(e.slices) do liveSlices[k] = true end
+  end
+  for k in pairs(_slices) do
+    if not liveSlices[k] then _slices[k] = nil end
+  end
+  for sig in pairs(_models) do
+    if not liveModels[sig] then _models[sig] = nil end
+  end
+  local liveIds = {}
+  for k in pairs(_slices) do
+    liveIds[tonumber(k:match(":(%d+)$"))] = true
+  end
+  for content, byPos in pairs(_contentIds) do
+    local any = false
+    for posKey, id in pairs(byPos) do
+      if liveIds[id] then any = true else byPos[posKey] = nil end
+    end
+    if not any then _contentIds[content] = nil end
+  end
+end
+
+function timelineCache.invalidate()
+  _sprite = nil
+  _frames, _models, _slices, _contentIds = {}, {}, {}, {}
+  _frameCount = 0
+end
+
+--------------------------------------------------------------------------------
+-- timelineCache.getModel(sprite, frameNumber)
+-- Returns the voxel model for a frame; the same table as last time when the
+-- frame's visible cels are unchanged. Callers must not modify it.
+--------------------------------------------------------------------------------
+function timelineCache.getModel(sprite, frameNumber)
+  if not sprite then return {} end
+  if _sprite ~= sprite then
+    timelineCache.invalidate()
+    _sprite = sprite
+  end
+  local layers = visibleLayers(sprite)
+
+  -- Frame signature from per-layer slice keys
+  local keys = {}
+  for z, layer in ipairs(layers) do
+    local cel = layer:cel(frameNumber)
+    if cel and cel.image then
+      local id = celContentId(cel)
+      if not id then
+        _stats.uncached = _stats.uncached + 1
+        return buildDirect(layers, frameNumber)
+      end
+      keys[#keys + 1] = z .. ":" .. id
+    end
+  end
+  local sig = table.concat(keys, "|")
+
+  local entry = _frames[frameNumber]
+  if entry and entry.sig == sig then
+    _stats.hits = _stats.hits + 1
+    return entry.model
+  end
+
+  local model = _models[sig]
+  if model then
+    _stats.hits = _stats.hits + 1
+  else
+    _stats.builds = _stats.builds + 1
+    local vb = getVoxelBuffer()
+    local buf = vb.new()
+    local ki = 0
+    for z, layer in ipairs(layers) do
+      local cel = layer:cel(frameNumber)
+      if cel and cel.image then
+        ki = ki + 1
+        local k = keys[ki]
+        local slice = _slices[k]
+        if slice then
+          _stats.sliceHits = _stats.sliceHits + 1
+        else
+          _stats.sliceBuilds = _stats.sliceBuilds + 1
+          slice = voxelizeCel(cel, z, vb.new())
+          _slices[k] = slice
+        end
+        vb.append(buf, slice)
+      end
+    end
+    model = vb.model(buf)
+    _models[sig] = model
+  end
+
+  if not entry then _frameCount = _frameCount + 1 end
+  _frames[frameNumber] = { sig = sig, model = model, slices = keys }
+  -- Keep the frames nearest to the one just requested
+  if _frameCount > timelineCache.MAX_FRAMES then
+    local far, farDist = nil, -1
+    for f in pairs(_frames) do
+      local d = math.abs(f - frameNumber)
+      if d > farDist then far, farDist = f, d end
+    end
+    _frames[far] = nil
+    _frameCount = _frameCount - 1
+  end
+  -- Every new or changed entry: content ids and slices of cels whose bytes
+  -- changed under a retained frame go as soon as nothing refers to them
+  sweep()
+  return model
+end
+
+-- True when a model for the frame was built (getModel re-checks its cels)
+function timelineCache.has(frameNumber)
+  return _frames[frameNumber] ~= nil
+end
+
+function timelineCache.getStats()
+  local slices = 0
+  for _ in pairs(_slices) do slices = slices + 1 end
+  local models = 0
+  for _ in pairs(_models) do models = models + 1 end
+  return {
+    frames = _frameCount,
+    models = models,
+    slices = slices,
+    hits = _stats.hits,
+    builds = _stats.builds,
+    sliceHits = _stats.sliceHits,
+    sliceBuilds = _stats.sliceBuilds,
+    uncached = _stats.uncached
+  }
+end
+
+return timelineCache
@@ -0,0 +1,197 @@
+-- voxel_buffer.lua
+-- Packed voxel storage: parallel integer arrays x, y, z and one packed RGBA
+-- integer per voxel (same layout as brick_cache.packColor: r<<24|g<<16|b<<8|a),
+-- with count and bounds. Array slots cost a few bytes per voxel where each
+-- {x,y,z,color={r,g,b,a}} voxel costs two tables. Generated models are
+-- read-only proxies over a buffer: model[i] builds a {x,y,z,color} view on
+-- access (nothing is stored per voxel), and the hot paths (brick_cache,
+-- renderPreview, exports, native requests) read the arrays directly.
+--
+-- buf = { n, x = {}, y = {}, z = {}, rgba = {}, minX, maxX, minY, maxY, minZ, maxZ }
+
+local voxelBuffer = {}
+
+local floor = math.floor
+
+--------------------------------------------------------------------------------
+-- Colors
+--------------------------------------------------------------------------------
+function voxelBuffer.pack(r, g, b, a)
+  return ((r * 256 + g) * 256 + b) * 256 + a
+end
+
+function voxelBuffer.unpack(rgba)
+  return (rgba >> 24) & 255, (rgba >> 16) & 255, (rgba >> 8) & 255, rgba & 255
+end
+
+-- Normalizes any voxel color ({r,g,b,a}, {red,...}, Color) once
+local function clamp8(v) v = floor(v or 255); return v < 0 and 0 or (v > 255 and 255 or v) end
+function voxelBuffer.packColor(c)
+  if not c then return 0xFFFFFFFF end
+  return voxelBuffer.pack(clamp8(c.r or c.red), clamp8(c.g or c.green),
+    clamp8(c.b or c.blue), clamp8(c.a or c.alpha))
+end
+
+-- Shared {r,g,b,a} per packed color (weak: unused colors are collected).
+-- Callers must not modify the returned table.
+local _colors = setmetatable({}, { __mode = "v" })
+function voxelBuffer.color(rgba)
+  local c = _colors[rgba]
+  if not c then
+    local r, g, b, a = voxelBuffer.unpack(rgba)
+    c = { r = r, g = g, b = b, a = a }
+    _colors[rgba] = c
+  end
+  return c
+end
+
+--------------------------------------------------------------------------------
+-- Buffers
+--------------------------------------------------------------------------------
+function voxelBuffer.new()
+  return {
+    n = 0, x = {}, y = {}, z = {}, rgba = {},
+    minX = math.huge, maxX = -math.huge,
+    minY = math.huge, maxY = -math.huge,
+    minZ = math.huge, maxZ = -math.huge,
+    isVoxelBuffer = true
+  }
+end
+
+function voxelBuffer.push(buf, x, y, z, rgba)
+  local n = buf.n + 1
+  buf.n = n
+  buf.x[n], buf.y[n], buf.z[n], buf.rgba[n] = x, y, z, rgba
+  if x < buf.minX then buf.minX = x end
+  if x > buf.maxX then buf.maxX = x end
+  if y < buf.minY then buf.minY = y end
+  if y > buf.maxY then buf.maxY = y end
+  if z < buf.minZ then buf.minZ = z end
+  if z > buf.maxZ then buf.maxZ = z end
+end
+
+function voxelBuffer.append(buf, other)
+  local x, y, z, rgba = other.x, other.y, other.z, other.rgba
+  for i = 1, other.n do voxelBuffer.push(buf, x[i], y[i], z[i], rgba[i]) end
+  return buf
+end
+
+-- x, y, z, r, g, b, a of voxel i
+function voxelBuffer.get(buf, i)
+  local r, g, b, a = voxelBuffer.unpack(buf.rgba[i])
+  return buf.x[i], buf.y[i], buf.z[i], r, g, b, a
+end
+
+function voxelBuffer.bounds(buf)
+  if buf.n == 0 then
+    return { minX = 0, maxX = 0, minY = 0, maxY = 0, minZ = 0, maxZ = 0 }
+  end
+  return { minX = buf.minX, maxX = buf.maxX, minY = buf.minY,
+           maxY = buf.maxY, minZ = buf.minZ, maxZ = buf.maxZ }
+end
+
+--------------------------------------------------------------------------------
+-- Models <-> buffers
+--------------------------------------------------------------------------------
+-- Plain model table -> its buffer. Plain tables can be edited in place, so
+-- lookups re-check the length and spot-check a few voxels (sampleMatches).
+local _byModel = setmetatable({}, { __mode = "k" })
+
+local function sampleMatches(model, buf, i)
+  local v = model[i]
+  return v ~= nil and v.x == buf.x[i] and v.y == buf.y[i] and v.z == buf.z[i]
+    and voxelBuffer.packColor(v.color) == buf.rgba[i]
+end
+
+-- Proxy models keep their buffer under a private key; ipairs and # go
+-- through the metatable, so existing model[i] / #model readers still work.
+local BUF = {}
+local MODEL_MT = {
+  __len = function(m) return rawget(m, BUF).n end,
+  __index = function(m, i)
+    local buf = rawget(m, BUF)
+    if math.type(i) ~= "integer" or i < 1 or i > buf.n then return nil end
+    return { x = buf.x[i], y = buf.y[i], z = buf.z[i], color = voxelBuffer.color(buf.rgba[i]) }
+  end,
+  __newindex = function(m, k, v)
+    if math.type(k) == "integer" then error("voxel models are read-only", 2) end
+    rawset(m, k, v)
+  end
+}
+
+function voxelBuffer.attach(model, buf)
+  _byModel[model] = buf
+  return model
+end
+
+function voxelBuffer.fromModel(model)
+  local buf = voxelBuffer.new()
+  for i = 1, #model do
+    local v = model[i]
+    voxelBuffer.push(buf, v.x, v.y, v.z, voxelBuffer.packColor(v.color))
+  end
+  return buf
+end
+
+-- Backing buffer of a proxy model, or nil for plain tables. Proxies are
+-- immutable, so callers may cache per buffer without re-checking contents.
+function voxelBuffer.backing(model)
+  if model.isVoxelBuffer then return model end
+  return rawget(model, BUF)
+end
+
+-- Attached/cached buffer for a model, or nil (never builds one). For plain
+-- tables the first, middle and last voxels must still match the buffer:
+-- cheap, and catches recolored or moved voxels at those positions only.
+function voxelBuffer.peek(model)
+  local buf = voxelBuffer.backing(model)
+  if buf then return buf end
+  buf = _byModel[model]
+  if not buf then return nil end
+  local n = buf.n
+  if n ~= #model then return nil end
+  if n > 0 and not (sampleMatches(model, buf, 1) and sampleMatches(model, buf, n)
+                    and sampleMatches(model, buf, (n + 1) // 2)) then
+    return nil
+  end
+  return buf
+end
+
+-- Buffer for a model (cached per model table); buffers pass through
+function voxelBuffer.of(model)
+  if not model then return voxelBuffer.new() end
+  local buf = voxelBuffer.peek(model)
+  if not buf then
+    buf = voxelBuffer.fromModel(model)
+    _byModel[model] = buf
+  end
+  return buf
+end
+
+-- Read-only model over buf (the buffer must not be pushed to afterwards)
+function voxelBuffer.model(buf)
+  return setmetatable({ [BUF] = buf }, MODEL_MT)
+end
+
+-- { {x,y,z,r,g,b,a}, ... } as the native render_* calls take it; built once
+-- per buffer and reused by later frames (the module only reads it)
+function voxelBuffer.nativeVoxels(buf)
+  local flat = buf.native
+  if flat then return flat end
+  flat = {}
+  local x, y, z, rgba = buf.x, buf.y, buf.z, buf.rgba
+  for i = 1, buf.n do
+    local r, g, b, a = voxelBuffer.unpack(rgba[i])
+    flat[i] = { x[i], y[i], z[i], r, g, b, a }
+  end
+  buf.native = flat
+  return flat
+end
+
+-- Numeric key for a coordinate (|x|,|y|,|z| < 2^16; exact as float too),
+-- for occupancy maps without string keys
+function voxelBuffer.key(x, y, z)
+  return ((x + 65536) * 131072 + (y + 65536)) * 131072 + (z + 65536)
+end
+
+return voxelBuffer
@@ -154,7 +154,9 @@ function voxelGenerator.generateVoxelModel(sprite)
     local frame = _activeFrameNumber()
     _refreshCacheForRange(sprite, startIdx, endIdx, frame)
 
-    local model = {}
+    local vb = AseVoxel.render.voxel_buffer
+    local pc = app.pixelColor
+    local buf = vb.new()
     local zCounter = 0
     for i = startIdx, endIdx do
       zCounter = zCounter + 1
@@ -164,29 +166,26 @@ function voxelGenerator.generateVoxelModel(sprite)
         for y = 0, img.height - 1 do
           for x = 0, img.width - 1 do
             local px = img:getPixel(x, y)
-            local a = app.pixelColor.rgbaA(px)
+            local a = pc.rgbaA(px)
             if a > 0 then
-              model[#model+1] = {
-                x = x + entry.pos.x,
-                y = y + entry.pos.y,
-                z = zCounter,
-                color = {
-                  r = app.pixelColor.rgbaR(px),
-                  g = app.pixelColor.rgbaG(px),
-                  b = app.pixelColor.rgbaB(px),
-                  a = a
-                }
-              }
+              vb.push(buf, x + entry.pos.x, y + entry.pos.y, zCounter,
+                vb.pack(pc.rgbaR(px), pc.rgbaG(px), pc.rgbaB(px), a))
             end
           end
         end
       end
     end
-    return model
+    return vb.model(buf)
   end
 
-  -- Standard path
-  local model = {}
+  -- Standard path (timeline cache: unchanged frames return the same model)
+  local timelineCache = AseVoxel.render.timeline_cache
+  if timelineCache and timelineCache.enabled then
+    return timelineCache.getModel(sprite, _activeFrameNumber())
+  end
+  local vb = AseVoxel.render.voxel_buffer
+  local pc = app.pixelColor
+  local buf = vb.new()
   local visibleLayers = {}
   for _, layer in ipairs(sprite.layers) do
     if not layer.isGroup and layer.isVisible then
@@ -202,30 +201,26 @@ function voxelGenerator.generateVoxelModel(sprite)
       for y = 0, image.height - 1 do
         for x = 0, image.width - 1 do
           local px = image:getPixel(x, y)
-            if app.pixelColor.rgbaA(px) > 0 then
-            model[#model+1] = {
-              x = x + cel.position.x,
-              y = y + cel.position.y,
-              z = z,
-              color = {
-                r = app.pixelColor.rgbaR(px),
-                g = app.pixelColor.rgbaG(px),
-                b = app.pixelColor.rgbaB(px),
-                a = app.pixelColor.rgbaA(px)
-              }
-            }
+          local a = pc.rgbaA(px)
+          if a > 0 then
+            vb.push(buf, x + cel.position.x, y + cel.position.y, z,
+              vb.pack(pc.rgbaR(px), pc.rgbaG(px), pc.rgbaB(px), a))
           end
         end
       end
     end
   end
-  return model
+  return vb.model(buf)
 end
 
 function voxelGenerator.calculateModelBounds(model)
   if #model == 0 then
     return {minX=0, maxX=0, minY=0, maxY=0, minZ=0, maxZ=0}
   end
+  -- Generated models carry their packed buffer, which tracks bounds
+  local vb = AseVoxel.render.voxel_buffer
+  local buf = vb and vb.peek(model)
+  if buf then return vb.bounds(buf) end
   local minX, maxX = model[1].x, model[1].x
   local minY, maxY = model[1].y, model[1].y
   local minZ, maxZ = model[1].z, model[1].z
@@ -0,0 +1,212 @@
+-- memory_report.lua
+-- On-demand memory accounting for the Debug tab. Lua-side structure sizes
+-- are measured rather than estimated: each stage is rebuilt between full
+-- collections and the retained collectgarbage("count") delta is its heap
+-- cost. Image caches report their pixel payload (4 bytes per RGBA pixel;
+-- pixels live outside the Lua heap). Native figures come from the module's
+-- memory_stats() and per-frame alloc counters when the build provides them.
+-- Not for the hot path: a report runs several full collections.
+
+local memoryReport = {}
+
+local function getBrickCache() return AseVoxel.render.brick_cache end
+local function getFrameCache() return AseVoxel.render.frame_cache end
+local function getTimelineCache() return AseVoxel.render.timeline_cache end
+local function getMeshBuilder() return AseVoxel.render.mesh_builder end
+local function getRotation() return AseVoxel.math.rotation end
+local function getNativeBridge() return AseVoxel.render.native_bridge end
+local function getTelemetry() return AseVoxel.utils.telemetry end
+local function getVoxelBuffer() return AseVoxel.render.voxel_buffer end
+
+--------------------------------------------------------------------------------
+-- Measurement
+--------------------------------------------------------------------------------
+local function fullCollect()
+  collectgarbage("collect")
+  collectgarbage("collect")
+end
+
+-- KB of Lua heap still held by fn's result after a full collection
+local function retained(fn)
+  fullCollect()
+  local before = collectgarbage("count")
+  local ok, result = pcall(fn)
+  if not ok then return nil end
+  fullCollect()
+  local kb = collectgarbage("count") - before
+  return math.max(0, kb), result
+end
+
+-- One {x,y,z,color} table per voxel (the layout before voxel_buffer), for
+-- comparison: fresh tables, one level of nesting, nested tables shared
+-- between voxels (interned colors) stay shared
+local function cloneModel(model)
+  local out, copies = {}, {}
+  for i = 1, #model do
+    local v = {}
+    for k, val in pairs(model[i]) do
+      if type(val) == "table" then
+        local t = copies[val]
+        if not t then
+          t = {}
+          for k2, v2 in pairs(val) do t[k2] = v2 end
+          copies[val] = t
+        end
+        val = t
+      end
+      v[k] = val
+    end
+    out[i] = v
+  end
+  return out
+end
+
+local function imageBytes(entries)
+  local n, bytes = 0, 0
+  for _, e in pairs(entries or {}) do
+    local img = e.image
+    if img then
+      n = n + 1
+      bytes = bytes + img.width * img.height * 4
+    end
+  end
+  return n, bytes
+end
+
+--------------------------------------------------------------------------------
+-- Report
+--------------------------------------------------------------------------------
+-- model: the viewer's current voxel model (may be nil)
+-- Returns {
+--   luaHeapKB, voxels,
+--   stages = { { name, kb, bytesPerVoxel } ... },   -- Lua heap, measured
+--   caches = { { name, bytes, detail } ... },       -- pixel payloads / counts
+--   native = memory_stats() result or nil,
+--   frame = { luaAllocKB, luaAllocP95KB, drawAllocKB, nativeAllocs, nativeAllocBytes }
+-- }
+function memoryReport.collect(model, lastMetrics)
+  local report = { stages = {}, caches = {}, voxels = model and #model or 0 }
+  local n = report.voxels
+
+  local function stage(name, fn)
+    local kb = retained(fn)
+    if kb then
+      report.stages[#report.stages + 1] = {
+        name = name, kb = kb, bytesPerVoxel = n > 0 and kb * 1024 / n or nil
+      }
+    end
+  end
+
+  if n > 0 then
+    stage("Voxel tables (unpacked)", function() return cloneModel(model) end)
+    local vb = getVoxelBuffer()
+    if vb then
+      stage("Voxel model (packed)", function() return vb.model(vb.fromModel(model)) end)
+    end
+    local rotation = getRotation()
+    if rotation and rotation.optimizeVoxelModel then
+      stage("optimizeVoxelModel", function() return rotation.optimizeVoxelModel(model) end)
+    end
+    local brickCache = getBrickCache()
+    if brickCache then
+      -- Full rebuild so reused bricks are counted too (the next frame finds it cached)
+      brickCache.invalidate()
+      stage("Brick grid + shell", function()
+        brickCache.getShell(model)
+        return brickCache.update(model)
+      end)
+    end
+    local meshBuilder = getMeshBuilder()
+    if meshBuilder then
+      stage("Mesh (mesh_builder)", function() return meshBuilder.buildMesh(model) end)
+    end
+  end
+
+  -- Image caches
+  local generator = AseVoxel.render.voxel_generator
+  local renderer = AseVoxel.render.preview_renderer
+  local count, bytes = imageBytes(generator and generator.layerScrollMode.cache)
+  local count2, bytes2 = imageBytes(renderer and renderer.layerScrollMode and renderer.layerScrollMode.cache)
+  report.caches[#report.caches + 1] = {
+    name = "Layer-scroll cache", bytes = bytes + bytes2,
+    detail = string.format("%d images", count + count2)
+  }
+  local frameCache = getFrameCache()
+  if frameCache then
+    local s = frameCache.getStats()
+    report.caches[#report.caches + 1] = {
+      name = "Frame cache", bytes = s.bytes,
+      detail = string.format("%d frames, budget %.0f MB", s.entries, s.budget / (1024 * 1024))
+    }
+  end
+  local timelineCache = getTimelineCache()
+  if timelineCache then
+    local s = timelineCache.getStats()
+    report.caches[#report.caches + 1] = {
+      name = "Timeline cache",
+      detail = string.format("%d frames, %d models, %d slices (Lua heap)", s.frames, s.models, s.slices)
+    }
+  end
+
+  -- Native heap
+  local nativeBridge = getNativeBridge()
+  if nativeBridge and nativeBridge.isAvailable() and nativeBridge.getMemoryStats then
+    report.native = nativeBridge.getMemoryStats()
+  end
+
+  -- Per frame
+  local telemetry = getTelemetry()
+  local m = lastMetrics or {}
+  report.frame = {
+    luaAllocKB = m.luaAllocKB,
+    luaAllocP95KB = telemetry and telemetry.percentile("alloc.frame_kb", 0.95),
+    drawAllocKB = m.drawAllocKB,
+    nativeAllocs = m.nativeAllocs,
+    nativeAllocBytes = m.nativeAllocBytes
+  }
+
+  fullCollect()
+  report.luaHeapKB = collectgarbage("count")
+  return report
+end
+
+local function fmtBytes(bytes)
+  if not bytes then return "n/a" end
+  if bytes >= 1024 * 1024 then return string.format("%.1f MB", bytes / (1024 * 1024)) end
+  return string.format("%.1f KB", bytes / 1024)
+end
+
+-- Report -> display lines
+function memoryReport.format(report)
+  local lines = {}
+  local function add(fmt, ...) lines[#lines + 1] = string.format(fmt, ...) end
+  add("Lua heap: %s (%d voxels in current model)", fmtBytes(report.luaHeapKB * 1024), report.voxels)
+  for _, s in ipairs(report.stages) do
+    add("  %s: %s%s", s.name, fmtBytes(s.kb * 1024),
+      s.bytesPerVoxel and string.format(" (%.0f B/voxel)", s.bytesPerVoxel) or "")
+  end
+  for _, c in ipairs(report.caches) do
+    add("%s: %s", c.name, c.bytes and (fmtBytes(c.bytes) .. ", " .. c.detail) or c.detail)
+  end
+  local native = report.native
+  if native then
+    add("Native heap: peak %s, %s allocations, %s frees", fmtBytes(native.peak_bytes),
+      tostring(native.allocations or "?"), tostring(native.frees or "?"))
+    local names = {}
+    for name in pairs(native.bytes or {}) do names[#names + 1] = name end
+    table.sort(names)
+    for _, name in ipairs(names) do add("  %s: %s", name, fmtBytes(native.bytes[name])) end
+  else
+    add("Native heap: n/a (module missing or no memory_stats)")
+  end
+  local f = report.frame
+  add("Last frame: Lua %s (p95 %s, draw loop %s), native %s allocs / %s",
+    f.luaAllocKB and fmtBytes(f.luaAllocKB * 1024) or "n/a",
+    f.luaAllocP95KB and fmtBytes(f.luaAllocP95KB * 1024) or "n/a",
+    f.drawAllocKB and fmtBytes(f.drawAllocKB * 1024) or "n/a",
+    f.nativeAllocs and tostring(f.nativeAllocs) or "n/a",
+    f.nativeAllocBytes and fmtBytes(f.nativeAllocBytes) or "n/a")
+  return lines
+end
+
+return memoryReport
@@ -14,6 +14,111 @@ local function nowMs()
   return os.clock() * 1000
 end
 
+-- Same clock the profiler and scheduler stamp with (callers pass it back
+-- as startMs to record/traceSpan)
+function performanceProfiler.now()
+  return nowMs()
+end
+
+--------------------------------------------------------------------------------
+-- Trace mode: timestamped spans in a preallocated ring buffer (parallel
+-- arrays, overwritten oldest-first), exported as Chrome trace_event JSON.
+--------------------------------------------------------------------------------
+performanceProfiler.TRACE_CAPACITY = 16384
+
+-- Tracks (tid in the exported trace)
+local TRACK_MAIN, TRACK_NATIVE = 1, 2
+
+local _trace = nil   -- { cap, head, count, name, cat, ph, ts, dur, tid, detail }
+
+function performanceProfiler.startTrace(capacity)
+  local cap = capacity or performanceProfiler.TRACE_CAPACITY
+  local t = { cap = cap, head = 0, count = 0, dropped = 0,
+              name = {}, cat = {}, ph = {}, ts = {}, dur = {}, tid = {}, detail = {} }
+  for i = 1, cap do
+    t.name[i], t.cat[i], t.ph[i] = "", "", "X"
+    t.ts[i], t.dur[i], t.tid[i], t.detail[i] = 0.0, 0.0, TRACK_MAIN, false
+  end
+  _trace = t
+end
+
+function performanceProfiler.stopTrace()
+  if _trace then _trace.stopped = true end
+end
+
+function performanceProfiler.isTracing()
+  return _trace ~= nil and not _trace.stopped
+end
+
+local function tracePush(ph, name, cat, ts, dur, tid, detail)
+  local t = _trace
+  local i = t.head % t.cap + 1
+  t.head = i
+  if t.count < t.cap then t.count = t.count + 1 else t.dropped = t.dropped + 1 end
+  t.name[i], t.cat[i], t.ph[i] = name, cat or "", ph
+  t.ts[i], t.dur[i], t.tid[i], t.detail[i] = ts, dur, tid or TRACK_MAIN, detail or false
+end
+
+-- Complete span [startMs, startMs + durMs]; track "native" draws on its own row
+function performanceProfiler.traceSpan(name, startMs, durMs, cat, detail, track)
+  if not (_trace and not _trace.stopped) then return end
+  tracePush("X", name, cat, startMs, durMs, track == "native" and TRACK_NATIVE or TRACK_MAIN, detail)
+end
+
+function performanceProfiler.traceInstant(name, cat, detail)
+  if not (_trace and not _trace.stopped) then return end
+  tracePush("i", name, cat, nowMs(), 0, TRACK_MAIN, detail)
+end
+
+function performanceProfiler.getTraceStats()
+  if not _trace then return { enabled = false, events = 0, capacity = 0, dropped = 0 } end
+  return { enabled = not _trace.stopped, events = _trace.count,
+           capacity = _trace.cap, dropped = _trace.dropped }
+end
+
+local function jsonStr(v)
+  return '"' .. tostring(v):gsub('[%c"\\]', function(c)
+    return string.format("\\u%04x", c:byte())
+  end) .. '"'
+end
+
+-- Chrome trace_event JSON (chrome://tracing, ui.perfetto.dev); ts/dur in us
+function performanceProfiler.exportTrace()
+  local t = _trace
+  local out = {
+    '{"displayTimeUnit":"ms","traceEvents":[\n',
+    '{"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"Lua"}},\n',
+    '{"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"Native stages"}}'
+  }
+  if t then
+    local first = (t.count < t.cap) and 1 or (t.head % t.cap + 1)
+    for n = 0, t.count - 1 do
+      local i = (first - 1 + n) % t.cap + 1
+      local ev = string.format('{"name":%s,"cat":%s,"ph":"%s","ts":%.1f,"pid":1,"tid":%d',
+        jsonStr(t.name[i]), jsonStr(t.cat[i]), t.ph[i], t.ts[i] * 1000, t.tid[i])
+      if t.ph[i] == "X" then
+        ev = ev .. string.format(',"dur":%.1f', t.dur[i] * 1000)
+      else
+        ev = ev .. ',"s":"t"'
+      end
+      if t.detail[i] then
+        ev = ev .. ',"args":{"detail":' .. jsonStr(t.detail[i]) .. '}'
+      end
+      out[#out + 1] = ",\n" .. ev .. "}"
+    end
+  end
+  out[#out + 1] = "\n]}\n"
+  return table.concat(out)
+end
+
+function performanceProfiler.writeTrace(path)
+  local f, err = io.open(path, "w")
+  if not f then return false, err end
+  f:write(performanceProfiler.exportTrace())
+  f:close()
+  return true
+end
+
 -- Statistical calculations
 local function calculateStats(samples)
   if #samples == 0 then
@@ -92,23 +197,35 @@ function performanceProfiler.measure(sectionName)
   local profile = performanceProfiler._profiles[performanceProfiler._activeProfile]
   if not profile or not profile.timestamps[sectionName] then return end
   
-  local duration = nowMs() - profile.timestamps[sectionName]
+  local start = profile.timestamps[sectionName]
+  local duration = nowMs() - start
+  profile.timestamps[sectionName] = nil
+  performanceProfiler.record(sectionName, duration, start)
+  
+  return duration
+end
+
+-- Record a duration measured elsewhere (e.g. native per-stage timings).
+-- startMs/track only place the span in the trace (default: ending now).
+function performanceProfiler.record(sectionName, durationMs, startMs, track)
+  local profile = performanceProfiler._profiles[performanceProfiler._activeProfile]
+  if not profile or type(durationMs) ~= "number" then return end
+  if _trace and not _trace.stopped then
+    performanceProfiler.traceSpan(sectionName, startMs or (nowMs() - durationMs), durationMs,
+      performanceProfiler._activeProfile, nil, track)
+  end
   
   if not profile.sections[sectionName] then
     profile.sections[sectionName] = {}
   end
   
-  table.insert(profile.sections[sectionName], duration)
+  table.insert(profile.sections[sectionName], durationMs)
   
   -- Limit sample count
   local samples = profile.sections[sectionName]
   while #samples > performanceProfiler._maxSamples do
     table.remove(samples, 1)
   end
-  
-  profile.timestamps[sectionName] = nil
-  
-  return duration
 end
 
 -- Convenience function: mark and measure in one call
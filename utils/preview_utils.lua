@@ -88,6 +88,89 @@ function previewUtils.updatePreview(dlg, params)
   }
 end
 
+--------------------------------------------------------------------------------
+-- Turntable setup shared by in-sprite animations and file export
+--------------------------------------------------------------------------------
+
+-- Step count, per-step angle and frame duration (ms) for animation params
+local function animationTiming(params)
+  local steps        = tonumber(params.animationSteps) or 36
+  local totalRotation= tonumber(params.totalRotation) or 360
+  return steps, totalRotation / steps, math.ceil(1440 / steps), totalRotation
+end
+
+-- Per-frame camera views (Euler for the renderer, matrix kept for native)
+function previewUtils.buildAnimationViews(params)
+  local mathUtils = getMathUtils()
+  local rotation = getRotation()
+  local steps, perStep = animationTiming(params)
+  local startAngle = tonumber(params.startAngle) or 0
+  -- Base orientation (matrix) at animation start
+  local baseMatrix = params.rotationMatrix or mathUtils.createRotationMatrix(
+    params.xRotation or 0,
+    params.yRotation or 0,
+    params.zRotation or 0
+  )
+
+  local views = {}
+  for frame = 0, steps - 1 do
+    local angle = startAngle + frame * perStep
+    local ax = params.animationAxis
+    local frameMatrix
+    if ax == "X" or ax == "Y" or ax == "Z" then
+      -- Apply absolute model-space rotation relative to starting orientation
+      -- Use applyAbsoluteRotation on the baseMatrix with per-axis delta to keep co-dependent order
+      if ax == "X" then
+        frameMatrix = rotation.applyAbsoluteRotation(baseMatrix, angle, 0, 0)
+      elseif ax == "Y" then
+        frameMatrix = rotation.applyAbsoluteRotation(baseMatrix, 0, angle, 0)
+      else
+        frameMatrix = rotation.applyAbsoluteRotation(baseMatrix, 0, 0, angle)
+      end
+    elseif ax == "Pitch" or ax == "Yaw" or ax == "Roll" then
+      local pitch, yaw, roll = 0, 0, 0
+      if ax == "Pitch" then pitch = angle elseif ax == "Yaw" then yaw = angle else roll = angle end
+      -- Apply as relative (camera-space) increment from base each frame
+      frameMatrix = mathUtils.applyRelativeRotation(baseMatrix, pitch, yaw, roll)
+    else
+      frameMatrix = baseMatrix
+    end
+
+    -- Convert matrix to Euler for renderer (previewRenderer ignores direct matrix)
+    local e = mathUtils.matrixToEuler(frameMatrix)
+    views[frame + 1] = { xRotation = e.x, yRotation = e.y, zRotation = e.z, matrix = frameMatrix }
+  end
+  return views
+end
+
+-- Render params every turntable frame shares
+function previewUtils.animationRenderParams(params, modelDimensions)
+  return {
+    -- Pass through FOV/perspective mode for animation frames
+    fovDegrees = params.fovDegrees or (params.depthPerspective and (5 + (75-5)*(params.depthPerspective/100))) or 45,
+    orthogonal = params.orthogonalView,
+    perspectiveScaleRef = params.perspectiveScaleRef or "middle",
+    pixelSize = 1,
+    middlePoint = modelDimensions,
+    canvasSize = params.canvasSize,
+    scaleLevel = params.scaleLevel,
+    fxStack = params.fxStack,
+    shadingMode = params.shadingMode,
+    lighting = params.lighting,              -- propagate dynamic lighting
+    viewDir = params.viewDir or {0,0,1}
+  }
+end
+
+-- Canvas edge for a model: room for its diagonal at any orientation
+local function animationCanvasSize(modelDimensions)
+  local canvasSize = 300 -- Default size
+  if modelDimensions then
+    local diagonal = math.sqrt(modelDimensions.sizeX^2 + modelDimensions.sizeY^2 + modelDimensions.sizeZ^2)
+    canvasSize = math.max(150, math.floor(diagonal * 5))
+  end
+  return canvasSize
+end
+
 -- Creates an animation of the model rotating around a selected axis
 function previewUtils.createAnimation(voxelModel, modelDimensions, params)
   if not voxelModel or #voxelModel == 0 then
@@ -96,8 +179,6 @@ function previewUtils.createAnimation(voxelModel, modelDimensions, params)
   end
   
   local previewRenderer = getPreviewRenderer()
-  local mathUtils = getMathUtils()
-  local rotation = getRotation()
   
   local sprite = app.activeSprite
   if not sprite then
@@ -105,27 +186,7 @@ function previewUtils.createAnimation(voxelModel, modelDimensions, params)
     return false
   end
 
-  -- REPLACED: step/angle setup (adds startAngle & totalRotation)
-  local steps        = tonumber(params.animationSteps) or 36
-  local startAngle   = tonumber(params.startAngle) or 0
-  local totalRotation= tonumber(params.totalRotation) or 360
-  local perStep      = totalRotation / steps
-  local frameDuration = math.ceil(1440 / steps)
-  -- Pass through FOV/perspective mode for animation frames
-  local fovDegrees = params.fovDegrees or (params.depthPerspective and (5 + (75-5)*(params.depthPerspective/100))) or 45
-  local orthogonal = params.orthogonalView
-  local perspectiveScaleRef = params.perspectiveScaleRef or "middle"
-  -- Base orientation (matrix + Euler) at animation start
-  local baseMatrix = params.rotationMatrix or mathUtils.createRotationMatrix(
-    params.xRotation or 0,
-    params.yRotation or 0,
-    params.zRotation or 0
-  )
-  local baseEuler = {
-    x = params.xRotation or 0,
-    y = params.yRotation or 0,
-    z = params.zRotation or 0
-  }
+  local steps, perStep, frameDuration, totalRotation = animationTiming(params)
   
   local baseFilename = "animation"
   if sprite.filename then
@@ -133,11 +194,7 @@ function previewUtils.createAnimation(voxelModel, modelDimensions, params)
   end
   
   -- Create a new sprite for the animation
-  local canvasSize = 300 -- Default size
-  if modelDimensions then
-    local diagonal = math.sqrt(modelDimensions.sizeX^2 + modelDimensions.sizeY^2 + modelDimensions.sizeZ^2)
-    canvasSize = math.max(150, math.floor(diagonal * 5))
-  end
+  local canvasSize = animationCanvasSize(modelDimensions)
   local animSprite = Sprite(canvasSize, canvasSize, ColorMode.RGB)
   if sprite.colorMode == ColorMode.INDEXED or sprite.colorMode == ColorMode.RGB then
     -- Copy palette from original sprite
@@ -146,62 +203,30 @@ function previewUtils.createAnimation(voxelModel, modelDimensions, params)
       animSprite.palettes[1]:setColor(i, color)
     end
   end
-  
+
+  -- Render every frame in one batch (shared scene, parallel when native)
+  local views = previewUtils.buildAnimationViews(params)
+  local frameImages = previewRenderer.renderVoxelModelBatch(
+    voxelModel, previewUtils.animationRenderParams(params, modelDimensions), views)
+
+  -- Bulk insertion: all frames first, then one cel per frame
   app.transaction(function()
     -- Remove the default layer and create a new one
     animSprite:deleteLayer("Layer 1")
     local layer = animSprite:newLayer()
     layer.name = "Voxel Model"
 
-    for frame = 0, steps - 1 do
-      if frame > 0 then animSprite:newFrame() end
-      local angle = startAngle + frame * perStep
-      local ax = params.animationAxis
-      local frameMatrix
-      if ax == "X" or ax == "Y" or ax == "Z" then
-        -- Apply absolute model-space rotation relative to starting orientation
-        -- Use applyAbsoluteRotation on the baseMatrix with per-axis delta to keep co-dependent order
-        if ax == "X" then
-          frameMatrix = rotation.applyAbsoluteRotation(baseMatrix, angle, 0, 0)
-        elseif ax == "Y" then
-          frameMatrix = rotation.applyAbsoluteRotation(baseMatrix, 0, angle, 0)
-        else
-          frameMatrix = rotation.applyAbsoluteRotation(baseMatrix, 0, 0, angle)
-        end
-       elseif ax == "Pitch" or ax == "Yaw" or ax == "Roll" then
-         local pitch, yaw, roll = 0, 0, 0
-         if ax == "Pitch" then pitch = angle elseif ax == "Yaw" then yaw = angle else roll = angle end
-         -- Apply as relative (camera-space) increment from base each frame
-         frameMatrix = mathUtils.applyRelativeRotation(baseMatrix, pitch, yaw, roll)
-       else
-         frameMatrix = baseMatrix
-       end
-
-      -- Convert matrix to Euler for renderer (previewRenderer ignores direct matrix)
-      local e = mathUtils.matrixToEuler(frameMatrix)
-
-      local renderParams = {
-        x = e.x, y = e.y, z = e.z,
-        fovDegrees = fovDegrees,
-        orthogonal = orthogonal,
-        perspectiveScaleRef = perspectiveScaleRef,
-        pixelSize = 1,
-        middlePoint = modelDimensions,
-        canvasSize = params.canvasSize,
-        sprite = sprite,
-        scaleLevel = params.scaleLevel,
-        fxStack = params.fxStack,
-        shadingMode = params.shadingMode,
-        lighting = params.lighting,              -- propagate dynamic lighting
-        viewDir = params.viewDir or {0,0,1}
-      }
-
-      local frameImage = previewRenderer.renderVoxelModel(voxelModel, renderParams)
-      local cel = animSprite:newCel(layer, frame + 1, frameImage)
-      local offsetX = math.floor((canvasSize - frameImage.width) / 2)
-      local offsetY = math.floor((canvasSize - frameImage.height) / 2)
-      cel.position = Point(offsetX, offsetY)
-      animSprite.frames[frame + 1].duration = frameDuration / 1000
+    for frame = 2, steps do
+      animSprite:newEmptyFrame(frame)
+    end
+    for frame = 1, steps do
+      local frameImage = frameImages[frame]
+      if frameImage then
+        local offsetX = math.floor((canvasSize - frameImage.width) / 2)
+        local offsetY = math.floor((canvasSize - frameImage.height) / 2)
+        animSprite:newCel(layer, frame, frameImage, Point(offsetX, offsetY))
+      end
+      animSprite.frames[frame].duration = frameDuration / 1000
     end
     
     -- Set animation properties
@@ -217,4 +242,38 @@ function previewUtils.createAnimation(voxelModel, modelDimensions, params)
   return true
 end
 
+-- Streams the turntable to disk (PNG sequence / APNG / GIF) instead of
+-- creating sprite frames; params.exportFormat and params.exportPath select it
+function previewUtils.exportAnimation(voxelModel, modelDimensions, params)
+  if not voxelModel or #voxelModel == 0 then
+    app.alert("No voxels to animate!")
+    return false
+  end
+  local steps, _, frameDuration = animationTiming(params)
+  local canvasSize = animationCanvasSize(modelDimensions)
+  local renderParams = previewUtils.animationRenderParams(params, modelDimensions)
+  renderParams.width = canvasSize
+  renderParams.height = canvasSize
+
+  -- Frames stream from Timer ticks; the result is reported when they are done
+  local function done(files, err)
+    if not files then
+      app.alert("Animation export failed: " .. tostring(err))
+      return false
+    end
+    app.alert(string.format("Exported %d frames to:\n%s", steps,
+      (#files == 1) and files[1] or (files[1] .. " ... " .. files[#files])))
+    return true
+  end
+  local result, err = AseVoxel.io.export_turntable.export(
+    voxelModel, renderParams, previewUtils.buildAnimationViews(params), {
+      format = params.exportFormat,
+      path = params.exportPath,
+      delayMs = frameDuration,
+      onDone = done
+    })
+  if result == true then return true end
+  return done(result, err)
+end
+
 return previewUtils
\ No newline at end of file
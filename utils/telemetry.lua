@@ -0,0 +1,172 @@
+-- telemetry.lua
+-- Always-on, low-overhead latency telemetry. Each named metric is a pair of
+-- fixed-size log-linear histograms (HDR-style: 16 sub-buckets per power of
+-- two, ~6% resolution from 10 us to minutes). record() is O(1) and never
+-- allocates; percentiles scan the buckets. A metric's "window" keeps the
+-- current and previous interval, so percentiles follow recent behavior the
+-- way the old 50-sample arrays did without copying or sorting them.
+
+local telemetry = {}
+
+telemetry.enabled = true
+telemetry.DEFAULT_WINDOW = 50
+
+local UNITS_PER_MS = 100          -- bucket resolution: 10 us
+local SUB_BITS = 4
+local SUB = 1 << SUB_BITS         -- sub-buckets per octave
+local LINEAR = SUB * 2            -- values below this map 1:1
+local BUCKETS = 384               -- covers ~2^27 units (> 20 minutes)
+
+local _metrics = {}               -- name -> metric
+local _order = {}                 -- names in creation order
+
+--------------------------------------------------------------------------------
+-- Buckets
+--------------------------------------------------------------------------------
+local log = math.log
+local LOG2 = log(2)
+
+local function bucketOf(ms)
+  local u = math.floor(ms * UNITS_PER_MS)
+  if u < LINEAR then return (u < 0 and 0 or u) + 1 end
+  local msb = math.floor(log(u) / LOG2)
+  if (1 << (msb + 1)) <= u then msb = msb + 1 elseif (1 << msb) > u then msb = msb - 1 end
+  local shift = msb - SUB_BITS
+  local idx = LINEAR + (msb - SUB_BITS - 1) * SUB + ((u >> shift) - SUB) + 1
+  return idx > BUCKETS and BUCKETS or idx
+end
+
+-- Midpoint of a bucket, in ms
+local function valueOf(idx)
+  if idx <= LINEAR then return (idx - 1) / UNITS_PER_MS end
+  local k = idx - LINEAR - 1
+  local shift = k // SUB + 1
+  local top = SUB + k % SUB
+  local lo = top << shift
+  return (lo + (1 << shift) / 2) / UNITS_PER_MS
+end
+
+local function newCounts()
+  local c = {}
+  for i = 1, BUCKETS do c[i] = 0 end
+  return c
+end
+
+--------------------------------------------------------------------------------
+-- Metrics
+--------------------------------------------------------------------------------
+-- window: samples per interval (nil = cumulative, never rotates)
+function telemetry.metric(name, window)
+  local m = _metrics[name]
+  if m then return m end
+  m = {
+    name = name,
+    window = window,
+    cur = newCounts(), prev = newCounts(),
+    curN = 0, prevN = 0,
+    curSum = 0, prevSum = 0,
+    max = 0, last = 0,
+    total = 0
+  }
+  _metrics[name] = m
+  _order[#_order + 1] = name
+  return m
+end
+
+function telemetry.record(name, ms)
+  if not telemetry.enabled or type(ms) ~= "number" or ms ~= ms then return end
+  local m = _metrics[name] or telemetry.metric(name, telemetry.DEFAULT_WINDOW)
+  if m.window and m.curN >= m.window then
+    -- Rotate intervals: reuse the old "prev" array as the new current one
+    local old = m.prev
+    for i = 1, BUCKETS do old[i] = 0 end
+    m.prev, m.cur = m.cur, old
+    m.prevN, m.prevSum = m.curN, m.curSum
+    m.curN, m.curSum = 0, 0
+  end
+  local b = bucketOf(ms)
+  m.cur[b] = m.cur[b] + 1
+  m.curN = m.curN + 1
+  m.curSum = m.curSum + ms
+  m.total = m.total + 1
+  m.last = ms
+  if ms > m.max then m.max = ms end
+end
+
+function telemetry.count(name)
+  local m = _metrics[name]
+  return m and (m.curN + m.prevN) or 0
+end
+
+-- p in [0, 1] over the current + previous interval; nil without samples
+function telemetry.percentile(name, p)
+  local m = _metrics[name]
+  if not m then return nil end
+  local n = m.curN + m.prevN
+  if n == 0 then return nil end
+  local target = math.max(1, math.ceil(n * p))
+  local seen = 0
+  local cur, prev = m.cur, m.prev
+  for i = 1, BUCKETS do
+    seen = seen + cur[i] + prev[i]
+    if seen >= target then return valueOf(i) end
+  end
+  return valueOf(BUCKETS)
+end
+
+-- Summary for display (allocates one table; not for the hot path)
+function telemetry.getStats(name)
+  local m = _metrics[name]
+  if not m then return nil end
+  local n = m.curN + m.prevN
+  return {
+    count = n,
+    total = m.total,
+    last = m.last,
+    mean = n > 0 and (m.curSum + m.prevSum) / n or nil,
+    p50 = telemetry.percentile(name, 0.50),
+    p75 = telemetry.percentile(name, 0.75),
+    p95 = telemetry.percentile(name, 0.95),
+    p99 = telemetry.percentile(name, 0.99),
+    max = m.max
+  }
+end
+
+function telemetry.names()
+  return _order
+end
+
+function telemetry.reset(name)
+  local function clear(m)
+    for i = 1, BUCKETS do m.cur[i], m.prev[i] = 0, 0 end
+    m.curN, m.prevN, m.curSum, m.prevSum = 0, 0, 0, 0
+    m.max, m.last, m.total = 0, 0, 0
+  end
+  if name then
+    if _metrics[name] then clear(_metrics[name]) end
+  else
+    for _, m in pairs(_metrics) do clear(m) end
+  end
+end
+
+--------------------------------------------------------------------------------
+-- Per-frame stage costs from a renderer metrics table (t_*_ms keys)
+--------------------------------------------------------------------------------
+local STAGE_KEYS = {
+  { "t_transformSort_ms", "stage.transformSort" },
+  { "t_draw_ms", "stage.draw" },
+  { "t_outline_ms", "stage.outline" },
+  { "t_downsample_ms", "stage.downsample" },
+  { "t_total_ms", "stage.total" }
+}
+
+function telemetry.recordStages(metrics)
+  if not telemetry.enabled or not metrics then return end
+  for i = 1, #STAGE_KEYS do
+    local k = STAGE_KEYS[i]
+    local v = metrics[k[1]]
+    if v then telemetry.record(k[2], v) end
+  end
+end
+
+return telemetry